@@ -0,0 +1,4 @@
+BENCH_LIST = $(sort $(patsubst %/bench.mk,%, $(shell find $(ROOT_DIR)tests/bench -type f -name bench.mk)))
+FULL_BENCHES := $(notdir $(BENCH_LIST))
+
+include $(ROOT_DIR)tests/bench/benchlist.mk
@@ -44,6 +44,24 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(TASK_PROFILER_ENABLE)), yes)
+    OPT_DEFS += -DTASK_PROFILER_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/task_profiler.c
+    TASK_PROFILER_TICKS_REQUIRED = yes
+endif
+
+ifeq ($(strip $(LATENCY_TRACE_ENABLE)), yes)
+    OPT_DEFS += -DLATENCY_TRACE_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/latency_trace.c
+    TASK_PROFILER_TICKS_REQUIRED = yes
+endif
+
+ifeq ($(strip $(TICKLESS_IDLE_ENABLE)), yes)
+    OPT_DEFS += -DTICKLESS_IDLE_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/tickless_idle.c
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/tickless_idle.c
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -468,6 +486,11 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
 
+    ifeq ($(strip $(RGB_MATRIX_FRAME_PACING_ENABLE)), yes)
+        OPT_DEFS += -DRGB_MATRIX_FRAME_PACING
+        TASK_PROFILER_TICKS_REQUIRED = yes
+    endif
+
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), aw20216s)
         SPI_DRIVER_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led
@@ -694,6 +717,15 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         else
             QUANTUM_LIB_SRC += serial_protocol.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
+            ifeq ($(strip $(SERIAL_DRIVER)), usart)
+                QUANTUM_LIB_SRC += serial_protocol_pipelined.c
+            endif
+        endif
+
+        ifeq ($(strip $(SPLIT_TELEMETRY_ENABLE)), yes)
+            OPT_DEFS += -DSPLIT_TELEMETRY_ENABLE
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_telemetry.c
+            TASK_PROFILER_TICKS_REQUIRED = yes
         endif
     endif
     COMMON_VPATH += $(QUANTUM_PATH)/split_common
@@ -956,6 +988,10 @@ ifeq ($(strip $(APA102_DRIVER_REQUIRED)), yes)
     SRC += apa102.c
 endif
 
+ifeq ($(strip $(TASK_PROFILER_TICKS_REQUIRED)), yes)
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/task_profiler.c
+endif
+
 ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_ADC=TRUE
     QUANTUM_LIB_SRC += analog.c
@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+    Dirty tracking shared by the ISSI drivers.
+
+    The PWM buffers are transmitted in fixed size chunks, at most 16 per buffer. Each chunk has a
+    bit in the bitmap, set whenever one of its registers changes, so that only the chunks that
+    actually changed since the previous flush are transmitted again.
+*/
+
+typedef uint16_t is31_dirty_t;
+
+/**
+ * Bit of the chunk containing the given register.
+ */
+static inline is31_dirty_t is31_dirty_bit(uint8_t reg, uint8_t chunk_size) {
+    return (is31_dirty_t)1 << (reg / chunk_size);
+}
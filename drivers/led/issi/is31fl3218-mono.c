@@ -45,7 +45,9 @@ is31fl3218_driver_t driver_buffers = {
 };
 
 void is31fl3218_write_register(uint8_t reg, uint8_t data) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
+#if defined(I2C_ASYNC_ENABLE)
+    i2c_write_register_async(IS31FL3218_I2C_ADDRESS << 1, reg, &data, 1, IS31FL3218_I2C_TIMEOUT, IS31FL3218_I2C_PERSISTENCE);
+#elif IS31FL3218_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
         if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, reg, &data, 1, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
     }
@@ -55,7 +57,9 @@ void is31fl3218_write_register(uint8_t reg, uint8_t data) {
 }
 
 void is31fl3218_write_pwm_buffer(void) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
+#if defined(I2C_ASYNC_ENABLE)
+    i2c_write_register_async(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT, IS31FL3218_I2C_PERSISTENCE);
+#elif IS31FL3218_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
         if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
     }
@@ -48,7 +48,9 @@ is31fl3236_driver_t driver_buffers[IS31FL3236_DRIVER_COUNT] = {{
 }};
 
 void is31fl3236_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3236_I2C_PERSISTENCE > 0
+#if defined(I2C_ASYNC_ENABLE)
+    i2c_write_register_async(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3236_I2C_TIMEOUT, IS31FL3236_I2C_PERSISTENCE);
+#elif IS31FL3236_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3236_I2C_PERSISTENCE; i++) {
         if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3236_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
     }
@@ -58,7 +60,9 @@ void is31fl3236_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3236_write_pwm_buffer(uint8_t index) {
-#if IS31FL3236_I2C_PERSISTENCE > 0
+#if defined(I2C_ASYNC_ENABLE)
+    i2c_write_register_async(i2c_addresses[index] << 1, IS31FL3236_REG_PWM, driver_buffers[index].pwm_buffer, 36, IS31FL3236_I2C_TIMEOUT, IS31FL3236_I2C_PERSISTENCE);
+#elif IS31FL3236_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3236_I2C_PERSISTENCE; i++) {
         if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3236_REG_PWM, driver_buffers[index].pwm_buffer, 36, IS31FL3236_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
     }
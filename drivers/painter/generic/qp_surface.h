@@ -10,6 +10,9 @@
 // Helper for determining buffer size required for a surface
 #define SURFACE_REQUIRED_BUFFER_BYTE_SIZE(w, h, bpp) ((((w) * (h) * (bpp)) + 7) / 8)
 
+// Helper for determining buffer size required for a palette surface, which also holds the palette itself
+#define SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(w, h, bpp) (SURFACE_REQUIRED_BUFFER_BYTE_SIZE(w, h, bpp) + (1 << (bpp)) * 3)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter surface configurables (add to your keyboard's config.h)
 
@@ -21,6 +24,26 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_RECTS
+/**
+ * @def This controls the maximum number of separate dirty rectangles each surface keeps track of.
+ *      Increasing this number allows for widgets drawn far apart to be transferred without the area in between them.
+ */
+#    define SURFACE_DIRTY_RECTS 1
+#endif
+
+#ifndef SURFACE_DIRTY_MERGE_DISTANCE
+/**
+ * @def This controls how close, in pixels, a change needs to be to an existing dirty rectangle to be merged into it,
+ *      rather than starting a new one. Only relevant if SURFACE_DIRTY_RECTS is greater than 1.
+ */
+#    define SURFACE_DIRTY_MERGE_DISTANCE 16
+#endif
+
+#if SURFACE_DIRTY_RECTS < 1 || SURFACE_DIRTY_RECTS > 255
+#    error SURFACE_DIRTY_RECTS must be between 1 and 255
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -50,6 +73,26 @@ painter_device_t qp_make_rgb565_surface(uint16_t panel_width, uint16_t panel_hei
  */
 painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
 
+/**
+ * Factory method for an 8bpp palette surface (aka framebuffer), holding up to 256 distinct colors.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated uint8_t buffer of size `SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(panel_width, panel_height, 8)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_make_palette8bpp_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+
+/**
+ * Factory method for a 4bpp palette surface (aka framebuffer), holding up to 16 distinct colors.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated uint8_t buffer of size `SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(panel_width, panel_height, 4)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_make_palette4bpp_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+
 /**
  * Helper method to draw the contents of the framebuffer to the target device.
  *
@@ -64,4 +107,16 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
  */
 bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface);
 
+/**
+ * Backs the target device with the surface, so that calling qp_flush() on the surface transfers its dirty regions to
+ * the target device, then flushes the target device.
+ *
+ * @param surface[in] the surface to draw into
+ * @param target[in] the target device to copy into on flush, or NULL to detach the surface
+ * @param x[in] the x-location of the surface on the target device
+ * @param y[in] the y-location of the surface on the target device
+ * @return whether the surface could be attached
+ */
+bool qp_surface_attach(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
@@ -29,24 +29,96 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+// Distance from the point to the rectangle, zero if it's inside
+static uint16_t qp_surface_dirty_distance(const surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    uint16_t dx = x < rect->l ? rect->l - x : (x > rect->r ? x - rect->r : 0);
+    uint16_t dy = y < rect->t ? rect->t - y : (y > rect->b ? y - rect->b : 0);
+    return QP_MAX(dx, dy);
+}
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
-    // Maintain dirty region
-    if (dirty->l > x) {
-        dirty->l        = x;
-        dirty->is_dirty = true;
+    dirty->is_dirty = true;
+
+    // Find the closest dirty rectangle
+    uint8_t  closest          = 0;
+    uint16_t closest_distance = UINT16_MAX;
+    for (uint8_t i = 0; i < dirty->count; ++i) {
+        uint16_t distance = qp_surface_dirty_distance(&dirty->rects[i], x, y);
+        if (distance == 0) {
+            return;
+        }
+        if (distance < closest_distance) {
+            closest          = i;
+            closest_distance = distance;
+        }
     }
-    if (dirty->r < x) {
-        dirty->r        = x;
-        dirty->is_dirty = true;
+
+    // Start a new rectangle if the change is far away from the others and there's one left
+    if (dirty->count == 0 || (dirty->count < SURFACE_DIRTY_RECTS && closest_distance > SURFACE_DIRTY_MERGE_DISTANCE)) {
+        surface_dirty_rect_t *rect = &dirty->rects[dirty->count++];
+        rect->l = rect->r = x;
+        rect->t = rect->b = y;
+        return;
     }
-    if (dirty->t > y) {
-        dirty->t        = y;
-        dirty->is_dirty = true;
+
+    // Otherwise grow the closest one to include it
+    surface_dirty_rect_t *rect = &dirty->rects[closest];
+    rect->l                    = QP_MIN(rect->l, x);
+    rect->r                    = QP_MAX(rect->r, x);
+    rect->t                    = QP_MIN(rect->t, y);
+    rect->b                    = QP_MAX(rect->b, y);
+}
+
+// Combines rectangles that have grown into or close to each other, so that no area is transferred twice
+void qp_surface_merge_dirty(surface_dirty_data_t *dirty) {
+    for (uint8_t i = 0; i < dirty->count; ++i) {
+        surface_dirty_rect_t *a = &dirty->rects[i];
+        for (uint8_t j = i + 1; j < dirty->count; ++j) {
+            surface_dirty_rect_t *b = &dirty->rects[j];
+            if (b->l > a->r + SURFACE_DIRTY_MERGE_DISTANCE || a->l > b->r + SURFACE_DIRTY_MERGE_DISTANCE || b->t > a->b + SURFACE_DIRTY_MERGE_DISTANCE || a->t > b->b + SURFACE_DIRTY_MERGE_DISTANCE) {
+                continue;
+            }
+            a->l = QP_MIN(a->l, b->l);
+            a->t = QP_MIN(a->t, b->t);
+            a->r = QP_MAX(a->r, b->r);
+            a->b = QP_MAX(a->b, b->b);
+
+            // Replace the merged rectangle with the last one, and start over as the grown one may now reach others
+            dirty->rects[j] = dirty->rects[--dirty->count];
+            j               = i;
+        }
     }
-    if (dirty->b < y) {
-        dirty->b        = y;
-        dirty->is_dirty = true;
+}
+
+void qp_surface_set_dirty(surface_painter_device_t *surface) {
+    surface->dirty.rects[0].l = 0;
+    surface->dirty.rects[0].t = 0;
+    surface->dirty.rects[0].r = surface->base.panel_width - 1;
+    surface->dirty.rects[0].b = surface->base.panel_height - 1;
+    surface->dirty.count      = 1;
+    surface->dirty.is_dirty   = true;
+}
+
+void qp_surface_clear_dirty(surface_painter_device_t *surface) {
+    surface->dirty.count    = 0;
+    surface->dirty.is_dirty = false;
+}
+
+// Transfers the dirty regions, or the entire surface, to the target device
+static bool qp_surface_transfer(surface_painter_device_t *surface, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+    surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface->base.driver_vtable;
+    if (entire_surface) {
+        return vtable->target_pixdata_transfer(&surface->base, target_driver, x, y, 0, 0, surface->base.panel_width - 1, surface->base.panel_height - 1);
+    }
+
+    qp_surface_merge_dirty(&surface->dirty);
+    for (uint8_t i = 0; i < surface->dirty.count; ++i) {
+        surface_dirty_rect_t *rect = &surface->dirty.rects[i];
+        if (!vtable->target_pixdata_transfer(&surface->base, target_driver, x, y, rect->l, rect->t, rect->r, rect->b)) {
+            return false;
+        }
     }
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -56,13 +128,7 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
     memset(surface->buffer, 0, SURFACE_REQUIRED_BUFFER_BYTE_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
-
-    surface->dirty.l        = 0;
-    surface->dirty.t        = 0;
-    surface->dirty.r        = surface->base.panel_width - 1;
-    surface->dirty.b        = surface->base.panel_height - 1;
-    surface->dirty.is_dirty = true;
-
+    qp_surface_set_dirty(surface);
     return true;
 }
 
@@ -80,9 +146,20 @@ bool qp_surface_clear(painter_device_t device) {
 bool qp_surface_flush(painter_device_t device) {
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
-    surface->dirty.l = surface->dirty.t = UINT16_MAX;
-    surface->dirty.r = surface->dirty.b = 0;
-    surface->dirty.is_dirty             = false;
+
+    // Transfer to the attached device first, if there is one
+    if (surface->target && surface->dirty.is_dirty) {
+        if (!qp_surface_transfer(surface, (painter_driver_t *)surface->target, surface->target_x, surface->target_y, false)) {
+            qp_dprintf("qp_surface_flush: fail (could not transfer to attached device)\n");
+            return false;
+        }
+        if (!qp_flush(surface->target)) {
+            qp_dprintf("qp_surface_flush: fail (could not flush attached device)\n");
+            return false;
+        }
+    }
+
+    qp_surface_clear_dirty(surface);
     return true;
 }
 
@@ -116,26 +193,35 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
         return true;
     }
 
-    // If we have incompatible bit depths, drop out
-    if (surface_driver->native_bits_per_pixel != target_driver->native_bits_per_pixel) {
-        qp_dprintf("qp_surface_draw: fail (incompatible bpp: surface=%d, target=%d)\n", (int)surface_driver->native_bits_per_pixel, (int)target_driver->native_bits_per_pixel);
-        return false;
-    }
-
     // Offload to the pixdata transfer function
-    surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
-    bool                             ok     = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, entire_surface);
-    if (!ok) {
+    if (!qp_surface_transfer(surface_handle, target_driver, x, y, entire_surface)) {
         qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
         return false;
     }
 
     // Clear the dirty info for the surface
-    ok = qp_flush(surface);
-    if (!ok) {
-        qp_dprintf("qp_surface_draw: fail (could not flush)\n");
+    qp_surface_clear_dirty(surface_handle);
+    qp_dprintf("qp_surface_draw: ok\n");
+    return true;
+}
+
+bool qp_surface_attach(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y) {
+    painter_driver_t *        surface_driver = (painter_driver_t *)surface;
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+
+    if (!surface_driver || !surface_driver->validate_ok) {
+        qp_dprintf("qp_surface_attach: fail (invalid surface)\n");
         return false;
     }
-    qp_dprintf("qp_surface_draw: ok\n");
+
+    surface_handle->target   = target;
+    surface_handle->target_x = x;
+    surface_handle->target_y = y;
+
+    // Everything needs to be sent to a newly attached device
+    if (target) {
+        qp_surface_set_dirty(surface_handle);
+    }
+    qp_dprintf("qp_surface_attach: ok\n");
     return true;
 }
@@ -13,15 +13,21 @@
 typedef struct surface_painter_driver_vtable_t {
     painter_driver_vtable_t base; // must be first, so it can be cast to/from the painter_driver_vtable_t* type
 
-    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
+    // Transfers the given region of the surface to the target, offset by x and y
+    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 } surface_painter_driver_vtable_t;
 
-typedef struct surface_dirty_data_t {
-    bool     is_dirty;
+typedef struct surface_dirty_rect_t {
     uint16_t l;
     uint16_t t;
     uint16_t r;
     uint16_t b;
+} surface_dirty_rect_t;
+
+typedef struct surface_dirty_data_t {
+    bool                 is_dirty;
+    uint8_t              count;
+    surface_dirty_rect_t rects[SURFACE_DIRTY_RECTS];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -52,6 +58,14 @@ typedef struct surface_painter_device_t {
 
     // Maintain a dirty region so we can stream only what we need
     surface_dirty_data_t dirty;
+
+    // Device that the dirty regions are transferred to on flush, if any
+    painter_device_t target;
+    uint16_t         target_x;
+    uint16_t         target_y;
+
+    // Number of palette entries in use, palette surfaces only
+    uint16_t palette_count;
 } surface_painter_device_t;
 
 /**
@@ -78,6 +92,30 @@ painter_device_t qp_make_rgb565_surface_advanced(surface_painter_device_t *devic
  */
 painter_device_t qp_make_mono1bpp_surface_advanced(surface_painter_device_t *device_table, size_t device_table_len, uint16_t panel_width, uint16_t panel_height, void *buffer);
 
+/**
+ * Factory method for an 8bpp palette surface (aka framebuffer).
+ *
+ * @param device_table[in] the table of devices to use for instantiation
+ * @param device_table_len[in] the length of the table of devices
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated uint8_t buffer of size `SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(panel_width, panel_height, 8)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_make_palette8bpp_surface_advanced(surface_painter_device_t *device_table, size_t device_table_len, uint16_t panel_width, uint16_t panel_height, void *buffer);
+
+/**
+ * Factory method for a 4bpp palette surface (aka framebuffer).
+ *
+ * @param device_table[in] the table of devices to use for instantiation
+ * @param device_table_len[in] the length of the table of devices
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated uint8_t buffer of size `SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(panel_width, panel_height, 4)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_make_palette4bpp_surface_advanced(surface_painter_device_t *device_table, size_t device_table_len, uint16_t panel_width, uint16_t panel_height, void *buffer);
+
 // Driver storage
 extern surface_painter_device_t surface_drivers[SURFACE_NUM_DEVICES];
 
@@ -89,6 +127,9 @@ bool qp_surface_flush(painter_device_t device);
 bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
+void qp_surface_set_dirty(surface_painter_device_t *surface);
+void qp_surface_clear_dirty(surface_painter_device_t *surface);
+void qp_surface_merge_dirty(surface_dirty_data_t *dirty);
 
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
@@ -109,6 +150,7 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
                 driver->base.offset_x              = 0;                                                                                                                       \
                 driver->base.offset_y              = 0;                                                                                                                       \
                 driver->buffer                     = buffer;                                                                                                                  \
+                driver->target                     = NULL;                                                                                                                    \
                 return (painter_device_t)driver;                                                                                                                              \
             }                                                                                                                                                                 \
         }                                                                                                                                                                     \
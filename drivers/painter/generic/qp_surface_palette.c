@@ -0,0 +1,248 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+
+#    include <stdlib.h>
+#    include "color.h"
+#    include "qp_draw.h"
+#    include "qp_surface_internal.h"
+#    include "qp_comms_dummy.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Surface driver impl: palette8bpp, palette4bpp
+//
+// Each pixel is an index into the surface's own palette, which is stored as HSV888 triplets directly after the pixel
+// data in the surface buffer. Colors are added to the palette as they're drawn -- once it's full, the closest existing
+// entry is used instead. The palette is reset whenever the surface is cleared.
+
+static inline uint8_t *palette_surface_palette(surface_painter_device_t *surface) {
+    return &surface->u8buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(surface->base.panel_width, surface->base.panel_height, surface->base.native_bits_per_pixel)];
+}
+
+static inline uint8_t getpixel_palette(surface_painter_device_t *surface, uint32_t pixel_num) {
+    if (surface->base.native_bits_per_pixel == 8) {
+        return surface->u8buffer[pixel_num];
+    }
+    return (surface->u8buffer[pixel_num / 2] >> ((pixel_num % 2) * 4)) & 0x0F;
+}
+
+static inline void setpixel_palette(surface_painter_device_t *surface, uint16_t x, uint16_t y, uint8_t index) {
+    uint16_t w = surface->base.panel_width;
+    uint16_t h = surface->base.panel_height;
+
+    // Drop out if it's off-screen
+    if (x >= w || y >= h) {
+        return;
+    }
+
+    // Skip messing with the dirty info if the original value already matches
+    uint32_t pixel_num = y * w + x;
+    if (getpixel_palette(surface, pixel_num) != index) {
+        // Update the dirty region
+        qp_surface_update_dirty(&surface->dirty, x, y);
+
+        // Update the pixel data in the buffer
+        if (surface->base.native_bits_per_pixel == 8) {
+            surface->u8buffer[pixel_num] = index;
+        } else {
+            uint8_t shift                    = (pixel_num % 2) * 4;
+            surface->u8buffer[pixel_num / 2] = (surface->u8buffer[pixel_num / 2] & ~(0x0F << shift)) | (index << shift);
+        }
+    }
+}
+
+static inline void append_pixel_palette(surface_painter_device_t *surface, uint8_t index) {
+    setpixel_palette(surface, surface->viewport.pixdata_x, surface->viewport.pixdata_y, index);
+    qp_surface_increment_pixdata_location(&surface->viewport);
+}
+
+// Stream pixel data to the current write position in GRAM
+static bool qp_surface_pixdata_palette(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    painter_driver_t *        driver  = (painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    const uint8_t *           data    = (const uint8_t *)pixel_data;
+    for (uint32_t pixel_counter = 0; pixel_counter < native_pixel_count; ++pixel_counter) {
+        if (driver->native_bits_per_pixel == 8) {
+            append_pixel_palette(surface, data[pixel_counter]);
+        } else {
+            append_pixel_palette(surface, (data[pixel_counter / 2] >> ((pixel_counter % 2) * 4)) & 0x0F);
+        }
+    }
+    return true;
+}
+
+// Distance between two colors, hue being circular
+static inline uint16_t palette_color_distance(const uint8_t *a, const uint8_t *b) {
+    uint8_t dh = a[0] - b[0];
+    dh         = QP_MIN(dh, (uint8_t)(b[0] - a[0]));
+    return dh + abs(a[1] - b[1]) + abs(a[2] - b[2]);
+}
+
+// Pixel colour conversion, finding or allocating the palette entry for each color
+static bool qp_surface_palette_convert_palette(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    painter_driver_t *        driver   = (painter_driver_t *)device;
+    surface_painter_device_t *surface  = (surface_painter_device_t *)driver;
+    uint8_t *                 entries  = palette_surface_palette(surface);
+    uint16_t                  capacity = 1 << driver->native_bits_per_pixel;
+
+    for (int16_t i = 0; i < palette_size; ++i) {
+        uint8_t  hsv[3]           = {palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v};
+        uint16_t closest          = 0;
+        uint16_t closest_distance = UINT16_MAX;
+        for (uint16_t j = 0; j < surface->palette_count && closest_distance > 0; ++j) {
+            uint16_t distance = palette_color_distance(&entries[j * 3], hsv);
+            if (distance < closest_distance) {
+                closest          = j;
+                closest_distance = distance;
+            }
+        }
+
+        // Add the color if it's not in the palette yet, and there's space left
+        if (closest_distance > 0 && surface->palette_count < capacity) {
+            closest = surface->palette_count++;
+            memcpy(&entries[closest * 3], hsv, 3);
+        }
+
+        palette[i].palette_idx = closest;
+    }
+    return true;
+}
+
+// Append pixels to the target location, keyed by the pixel index
+static bool qp_surface_append_pixels_palette(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (driver->native_bits_per_pixel == 8) {
+        for (uint32_t i = 0; i < pixel_count; ++i) {
+            target_buffer[pixel_offset + i] = palette[palette_indices[i]].palette_idx;
+        }
+    } else {
+        for (uint32_t i = 0; i < pixel_count; ++i) {
+            uint32_t pixel_num          = pixel_offset + i;
+            uint8_t  shift              = (pixel_num % 2) * 4;
+            target_buffer[pixel_num / 2] = (target_buffer[pixel_num / 2] & ~(0x0F << shift)) | (palette[palette_indices[i]].palette_idx << shift);
+        }
+    }
+    return true;
+}
+
+static bool qp_surface_append_pixdata_palette(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    return false; // Native pixel data is never palette-based.
+}
+
+static bool qp_surface_init_palette(painter_device_t device, painter_rotation_t rotation) {
+    painter_driver_t *        driver  = (painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    if (!qp_surface_init(device, rotation)) {
+        return false;
+    }
+
+    // The cleared pixel data refers to the first entry, which is black
+    memset(palette_surface_palette(surface), 0, 3);
+    surface->palette_count = 1;
+
+    // Any palette already converted for this surface, and any glyphs cached for it, refer to entries that no longer exist
+    qp_internal_invalidate_palette();
+    qp_internal_invalidate_glyph_cache(device);
+    return true;
+}
+
+static bool palette_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+
+    // The target converts the whole palette up front, so it needs to fit in the lookup table
+    if (surface_handle->palette_count > ARRAY_SIZE(qp_internal_global_pixel_lookup_table)) {
+        qp_dprintf("palette_target_pixdata_transfer: fail (palette too large (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE)\n", (int)surface_handle->palette_count);
+        return false;
+    }
+
+    // Convert the palette to the target's native format
+    const uint8_t *entries = palette_surface_palette(surface_handle);
+    for (uint16_t i = 0; i < surface_handle->palette_count; ++i) {
+        qp_internal_global_pixel_lookup_table[i].hsv888.h = entries[i * 3 + 0];
+        qp_internal_global_pixel_lookup_table[i].hsv888.s = entries[i * 3 + 1];
+        qp_internal_global_pixel_lookup_table[i].hsv888.v = entries[i * 3 + 2];
+    }
+    bool ok = target_driver->driver_vtable->palette_convert((painter_device_t)target_driver, surface_handle->palette_count, qp_internal_global_pixel_lookup_table);
+    if (!ok) {
+        qp_dprintf("palette_target_pixdata_transfer: fail (could not convert palette)\n");
+        return false;
+    }
+
+    // Set the target drawing area
+    ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
+    if (!ok) {
+        qp_dprintf("palette_target_pixdata_transfer: fail (could not set target viewport)\n");
+        return false;
+    }
+
+    // Housekeeping of the amount of pixels to transfer
+    uint32_t total_pixel_count = (8 * QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) / target_driver->native_bits_per_pixel;
+    uint32_t pixel_counter     = 0;
+    uint8_t  indices[32];
+    uint8_t  index_count = 0;
+
+    // Fill the global pixdata area in the target's format, so that we can start transferring to the panel
+    for (uint16_t y = t; y <= b; ++y) {
+        uint32_t pixel_num = y * surface_driver->panel_width + l;
+        for (uint16_t x = l; x <= r; ++x) {
+            indices[index_count++] = getpixel_palette(surface_handle, pixel_num++);
+
+            // Convert the accumulated indices once there's enough of them, or the buffer is about to be full
+            if (index_count == sizeof(indices) || pixel_counter + index_count == total_pixel_count) {
+                target_driver->driver_vtable->append_pixels((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_counter, index_count, indices);
+                pixel_counter += index_count;
+                index_count = 0;
+            }
+
+            // If we've accumulated enough data, send it
+            if (pixel_counter == total_pixel_count) {
+                ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
+                if (!ok) {
+                    qp_dprintf("palette_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
+                    return false;
+                }
+                // Reset the counter
+                pixel_counter = 0;
+            }
+        }
+    }
+
+    // If there's any leftover data, send it
+    if (index_count > 0) {
+        target_driver->driver_vtable->append_pixels((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_counter, index_count, indices);
+        pixel_counter += index_count;
+    }
+    if (pixel_counter > 0) {
+        ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
+        if (!ok) {
+            qp_dprintf("palette_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
+            return false;
+        }
+    }
+
+    // The lookup table no longer matches any interpolated palette
+    qp_internal_invalidate_palette();
+    return true;
+}
+
+const surface_painter_driver_vtable_t palette_surface_driver_vtable = {
+    .base =
+        {
+            .init            = qp_surface_init_palette,
+            .power           = qp_surface_power,
+            .clear           = qp_surface_clear,
+            .flush           = qp_surface_flush,
+            .pixdata         = qp_surface_pixdata_palette,
+            .viewport        = qp_surface_viewport,
+            .palette_convert = qp_surface_palette_convert_palette,
+            .append_pixels   = qp_surface_append_pixels_palette,
+            .append_pixdata  = qp_surface_append_pixdata_palette,
+        },
+    .target_pixdata_transfer = palette_target_pixdata_transfer,
+};
+
+SURFACE_FACTORY_FUNCTION_IMPL(qp_make_palette8bpp_surface, palette_surface_driver_vtable, 8);
+SURFACE_FACTORY_FUNCTION_IMPL(qp_make_palette4bpp_surface, palette_surface_driver_vtable, 4);
+
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
@@ -72,6 +72,7 @@ subcommands = [
     'qmk.cli.license_check',
     'qmk.cli.lint',
     'qmk.cli.kle2json',
+    'qmk.cli.latency',
     'qmk.cli.list.keyboards',
     'qmk.cli.list.keymaps',
     'qmk.cli.list.layouts',
@@ -81,6 +82,7 @@ subcommands = [
     'qmk.cli.new.keymap',
     'qmk.cli.painter',
     'qmk.cli.pytest',
+    'qmk.cli.split_telemetry',
     'qmk.cli.test.c',
     'qmk.cli.userspace.add',
     'qmk.cli.userspace.compile',
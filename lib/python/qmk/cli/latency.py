@@ -0,0 +1,51 @@
+"""Read key-to-report latency statistics from a keyboard.
+"""
+from milc import cli
+
+from qmk.raw_hid import open_raw_hid_device, raw_hid_command, unpack_u32_be
+
+# Must match `enum via_command_id` in quantum/via.h
+ID_LATENCY_TRACE_GET_STATS = 0x17
+LATENCY_TRACE_RESET = 0xFF
+
+# Must match `enum latency_trace_stage_t` in quantum/latency_trace.h
+STAGE_NAMES = ['debounce', 'process', 'report', 'total']
+
+
+@cli.argument('-d', '--device', help='Device to query, as VID:PID[:INDEX]. Defaults to the first keyboard found.')
+@cli.argument('-r', '--reset', arg_only=True, action='store_true', help='Reset the statistics after reading them.')
+@cli.subcommand('Read key-to-report latency statistics from a keyboard built with LATENCY_TRACE_ENABLE.')
+def latency(cli):
+    """Query each latency trace stage over raw HID and print the aggregated statistics.
+    """
+    try:
+        dev = open_raw_hid_device(cli.config.latency.device)
+    except ValueError as e:
+        cli.log.error(e)
+        return False
+
+    if not dev:
+        cli.log.error('No raw HID device found!')
+        return False
+
+    with dev:
+        stage = 0
+        stage_count = len(STAGE_NAMES)
+        dropped = 0
+        while stage < stage_count:
+            response = raw_hid_command(dev, [ID_LATENCY_TRACE_GET_STATS, stage])
+            if response is None:
+                cli.log.error('Keyboard does not support latency tracing, is LATENCY_TRACE_ENABLE set?')
+                return False
+
+            stage_count = response[2]
+            count, min_us, avg_us, max_us, dropped = (unpack_u32_be(response, 3 + i * 4) for i in range(5))
+            name = STAGE_NAMES[stage] if stage < len(STAGE_NAMES) else f'stage {stage}'
+            cli.echo(f'{{fg_cyan}}{name:>8}{{fg_reset}}: n={count} min={min_us}us avg={avg_us}us max={max_us}us')
+            stage += 1
+
+        cli.echo(f'{{fg_cyan}}{"dropped":>8}{{fg_reset}}: {dropped}')
+
+        if cli.args.reset:
+            raw_hid_command(dev, [ID_LATENCY_TRACE_GET_STATS, LATENCY_TRACE_RESET])
+            cli.log.info('Latency statistics reset.')
@@ -0,0 +1,70 @@
+"""Read split link health and throughput statistics from a keyboard.
+"""
+from milc import cli
+
+from qmk.raw_hid import open_raw_hid_device, raw_hid_command, unpack_u16_be, unpack_u32_be
+
+# Must match `enum via_command_id` in quantum/via.h
+ID_SPLIT_TELEMETRY_GET_STATS = 0x18
+SPLIT_TELEMETRY_CONTROL = 0xFF
+CONTROL_RESET = 0
+CONTROL_STRESS_OFF = 1
+CONTROL_STRESS_ON = 2
+
+# Must match `enum split_telemetry_half_t` in quantum/split_common/split_telemetry.h
+HALF_NAMES = ['master', 'slave']
+
+
+@cli.argument('-d', '--device', help='Device to query, as VID:PID[:INDEX]. Defaults to the first keyboard found.')
+@cli.argument('-r', '--reset', arg_only=True, action='store_true', help='Reset the statistics of both halves after reading them.')
+@cli.argument('-s', '--stress', arg_only=True, choices=['on', 'off'], help='Start or stop the link stress mode before reading the statistics.')
+@cli.subcommand('Read split link statistics from a keyboard built with SPLIT_TELEMETRY_ENABLE.')
+def split_telemetry(cli):
+    """Query each split transaction over raw HID and print the statistics of both halves.
+    """
+    try:
+        dev = open_raw_hid_device(cli.config.split_telemetry.device)
+    except ValueError as e:
+        cli.log.error(e)
+        return False
+
+    if not dev:
+        cli.log.error('No raw HID device found!')
+        return False
+
+    with dev:
+        if cli.args.stress:
+            action = CONTROL_STRESS_ON if cli.args.stress == 'on' else CONTROL_STRESS_OFF
+            if raw_hid_command(dev, [ID_SPLIT_TELEMETRY_GET_STATS, SPLIT_TELEMETRY_CONTROL, action]) is None:
+                cli.log.error('Keyboard does not support split telemetry, is SPLIT_TELEMETRY_ENABLE set?')
+                return False
+            cli.log.info(f'Stress mode turned {cli.args.stress}.')
+
+        for half, half_name in enumerate(HALF_NAMES):
+            transaction = 0
+            transaction_count = 1
+            response = None
+            while transaction < transaction_count:
+                response = raw_hid_command(dev, [ID_SPLIT_TELEMETRY_GET_STATS, half, transaction])
+                if response is None:
+                    break
+
+                transaction_count = response[3]
+                attempts, retries, failures, transferred = (unpack_u32_be(response, 4 + i * 4) for i in range(4))
+                min_us, avg_us, max_us = (unpack_u16_be(response, 20 + i * 2) for i in range(3))
+                if attempts:
+                    cli.echo(f'{{fg_cyan}}{half_name:>6} {transaction:>3}{{fg_reset}}: n={attempts} retries={retries} failures={failures} bytes={transferred} min={min_us}us avg={avg_us}us max={max_us}us')
+                transaction += 1
+
+            if response is None:
+                if half == 0:
+                    cli.log.error('Keyboard does not support split telemetry, is SPLIT_TELEMETRY_ENABLE set?')
+                    return False
+                cli.log.warning(f'Statistics of the {half_name} half are unavailable, is it connected?')
+                continue
+
+            cli.echo(f'{{fg_cyan}}{half_name:>6}{{fg_reset}}: corrupted={unpack_u32_be(response, 26)} invalid={unpack_u16_be(response, 30)}')
+
+        if cli.args.reset:
+            raw_hid_command(dev, [ID_SPLIT_TELEMETRY_GET_STATS, SPLIT_TELEMETRY_CONTROL, CONTROL_RESET])
+            cli.log.info('Split telemetry reset.')
@@ -430,3 +430,47 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+def compress_bytes_qmk_block_rle(bytearray):
+    """Compresses the supplied bytes using QMK's block RLE, which allows for runs of up to 16384 bytes.
+
+    Runs shorter than three repeated bytes are kept as part of the surrounding non-repeated run.
+    """
+    max_run_length = 16384
+    output = []
+    literal = []
+
+    def append_marker(non_repeating, length):
+        length -= 1
+        flags = 0x80 if non_repeating else 0x00
+        if length < 0x40:
+            output.append(flags | length)
+        else:
+            output.append(flags | 0x40 | (length >> 8))
+            output.append(length & 0xFF)
+
+    def append_literal():
+        while len(literal) > 0:
+            chunk = literal[:max_run_length]
+            append_marker(True, len(chunk))
+            output.extend(chunk)
+            del literal[:max_run_length]
+
+    n = 0
+    while n < len(bytearray):
+        c = bytearray[n]
+        run = 1
+        while n + run < len(bytearray) and bytearray[n + run] == c and run < max_run_length:
+            run += 1
+
+        if run >= 3:
+            append_literal()
+            append_marker(False, run)
+            output.append(c)
+        else:
+            literal.extend(bytearray[n:n + run])
+        n += run
+
+    append_literal()
+    return output
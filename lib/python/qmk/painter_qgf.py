@@ -260,15 +260,37 @@ def _for_all_frames(x: FunctionType, /, images):
             frame_num += 1
 
 
-def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwargs):
+def _rendered_frame(frame, format_):
+    """Approximates what the firmware displays for the supplied frame, so that differences which don't survive the
+    conversion to the output format can be ignored.
+    """
+    converted = qmk.painter.convert_requested_format(frame, format_)
+    image_format = format_["image_format"]
+    if image_format == 'IMAGE_FORMAT_GRAYSCALE':
+        max_value = format_["num_colors"] - 1
+        return converted.point(lambda v: qmk.painter.rescale_byte(v, max_value))
+    if image_format == 'IMAGE_FORMAT_RGB565':
+        return converted.point([v & 0xF8 for v in range(256)] + [v & 0xFC for v in range(256)] + [v & 0xF8 for v in range(256)])
+    return converted.convert("RGB")
+
+
+def _changed_pixels(a, b):
+    """Returns a mask of the pixels that differ between the two RGB images.
+    """
+    red, green, blue = ImageChops.difference(a, b).split()
+    return ImageChops.lighter(ImageChops.lighter(red, green), blue).point(lambda v: 255 if v else 0)
+
+
+def _compress_image(frame, last_frame, *, use_rle, use_block_rle, use_deltas, format_, **_kwargs):
     # Convert the original frame so we can do comparisons
     converted = qmk.painter.convert_requested_format(frame, format_)
     graphic_data = qmk.painter.convert_image_bytes(converted, format_)
 
     # Convert the raw data to RLE-encoded if requested
+    compress_rle = qmk.painter.compress_bytes_qmk_block_rle if use_block_rle else qmk.painter.compress_bytes_qmk_rle
     raw_data = graphic_data[1]
     if use_rle:
-        rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
+        rle_data = compress_rle(graphic_data[1])
     use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
     image_data = raw_data if use_raw_this_frame else rle_data
 
@@ -276,11 +298,14 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
     use_delta_this_frame = False
     bbox = None
     if use_deltas and last_frame is not None:
-        # If we want to use deltas, then find the difference
-        diff = ImageChops.difference(frame, last_frame)
+        # If we want to use deltas, then find the pixels which differ both in the source and once converted to the
+        # output format -- quantization can hide source changes, and can also differ in areas the source didn't change
+        source_diff = _changed_pixels(frame, last_frame)
+        rendered_diff = _changed_pixels(_rendered_frame(frame, format_), _rendered_frame(last_frame, format_))
 
-        # Get the bounding box of those differences
-        bbox = diff.getbbox()
+        # Get the bounding box of those differences, falling back to a single pixel if the frame is unchanged so that
+        # only its delay is applied
+        bbox = ImageChops.darker(source_diff, rendered_diff).getbbox() or (0, 0, 1, 1)
 
         # If we have a valid bounding box...
         if bbox:
@@ -294,7 +319,7 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
             # Work out how large the delta frame is going to be with compression etc.
             delta_raw_data = delta_graphic_data[1]
             if use_rle:
-                delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
+                delta_rle_data = compress_rle(delta_graphic_data[1])
             delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
             delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
 
@@ -347,7 +372,7 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
     frame_descriptor.is_delta = use_delta_this_frame
     frame_descriptor.is_transparent = False
     frame_descriptor.format = format_['image_format_byte']
-    frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
+    frame_descriptor.compression = 0x00 if use_raw_this_frame else (0x02 if kwargs["use_block_rle"] else 0x01)  # See qp.h, painter_compression_t
     frame_descriptor.delay = frame.info.get('duration', 1000)  # If we're not an animation, just pretend we're delaying for 1000ms
     frame_descriptor.write(fp)
 
@@ -437,7 +462,7 @@ def _save(im, fp, _filename):
     frame_offsets.write(fp)
 
     # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
+    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), use_block_rle=encoderinfo.get("use_block_rle", False), frame_offsets=frame_offsets, metadata=metadata)
     for_all_frames(write_frame)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
@@ -0,0 +1,74 @@
+"""Functions that help us talk to keyboards over the raw HID interface.
+"""
+from milc import cli
+
+# Must match RAW_USAGE_PAGE/RAW_USAGE_ID in tmk_core/protocol/usb_descriptor_common.h
+RAW_USAGE_PAGE = 0xFF60
+RAW_USAGE_ID = 0x61
+RAW_EPSIZE = 32
+
+# Must match `enum via_command_id` in quantum/via.h
+VIA_ID_UNHANDLED = 0xFF
+
+
+def parse_device_filter(device):
+    """Parse a `VID:PID[:INDEX]` string into its components.
+    """
+    parts = device.split(':')
+    if len(parts) not in (2, 3):
+        raise ValueError(f'Invalid device "{device}", expected VID:PID[:INDEX]')
+
+    vid = int(parts[0], 16)
+    pid = int(parts[1], 16)
+    index = int(parts[2]) if len(parts) == 3 else 1
+
+    return vid, pid, index
+
+
+def list_raw_hid_devices(vid=0, pid=0):
+    """Returns the raw HID interfaces of all connected keyboards, optionally filtered by VID/PID.
+    """
+    import hid
+
+    return [dev for dev in hid.enumerate(vid, pid) if dev['usage_page'] == RAW_USAGE_PAGE and dev['usage'] == RAW_USAGE_ID]
+
+
+def open_raw_hid_device(device=None):
+    """Opens the raw HID interface described by `VID:PID[:INDEX]`, or the first one found.
+    """
+    import hid
+
+    vid, pid, index = parse_device_filter(device) if device else (0, 0, 1)
+    devices = list_raw_hid_devices(vid, pid)
+    if len(devices) < index:
+        return None
+
+    cli.log.debug('Opening %s (%s)', devices[index - 1]['product_string'], devices[index - 1]['path'])
+    return hid.Device(path=devices[index - 1]['path'])
+
+
+def raw_hid_command(dev, data, timeout=500):
+    """Sends a single raw HID command and returns the response, or None if the command was not handled.
+    """
+    request = bytes(data) + bytes(RAW_EPSIZE - len(data))
+
+    # The first byte is the report ID, which is always zero for the raw HID interface
+    dev.write(b'\x00' + request)
+    response = dev.read(RAW_EPSIZE, timeout)
+
+    if len(response) != RAW_EPSIZE or response[0] == VIA_ID_UNHANDLED:
+        return None
+
+    return response
+
+
+def unpack_u32_be(data, offset):
+    """Read a big-endian 32-bit unsigned integer from a raw HID response.
+    """
+    return int.from_bytes(data[offset:offset + 4], byteorder='big')
+
+
+def unpack_u16_be(data, offset):
+    """Read a big-endian 16-bit unsigned integer from a raw HID response.
+    """
+    return int.from_bytes(data[offset:offset + 2], byteorder='big')
@@ -18,6 +18,9 @@
 #include <stdbool.h>
 #include "gpio.h"
 #include "serial.h"
+#ifdef SPLIT_TELEMETRY_ENABLE
+#    include "split_telemetry.h"
+#endif
 
 #ifdef SOFT_SERIAL_PIN
 
@@ -403,8 +406,15 @@ ISR(SERIAL_PIN_INTERRUPT) {
     tid  = bits >> 3;
     bits = (bits & 7) != (nibble_bits_count(tid) & 7);
     if (bits || pecount > 0 || tid > NUM_TOTAL_TRANSACTIONS) {
+#ifdef SPLIT_TELEMETRY_ENABLE
+        split_telemetry_record_invalid();
+#endif
         return;
     }
+#ifdef SPLIT_TELEMETRY_ENABLE
+    uint32_t start = split_telemetry_start();
+#endif
+    __attribute__((unused)) bool success = true;
     serial_delay_half1();
 
     serial_high(); // response step1 low->high
@@ -425,10 +435,22 @@ ISR(SERIAL_PIN_INTERRUPT) {
 
     // target recive phase
     if (trans->initiator2target_buffer_size > 0) {
-        serial_recive_packet((uint8_t *)split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        uint8_t received = 0;
+        // length prefixed buffers tell how much of them is sent with their first byte
+        if (trans->initiator2target_length_prefixed) {
+            success &= serial_recive_packet((uint8_t *)split_trans_initiator2target_buffer(trans), 1);
+            received = 1;
+        }
+        uint8_t length = split_trans_initiator2target_length(trans);
+        if (length > received) {
+            success &= serial_recive_packet((uint8_t *)split_trans_initiator2target_buffer(trans) + received, length - received);
+        }
     }
 
     sync_recv(); // weit initiator output to high
+#ifdef SPLIT_TELEMETRY_ENABLE
+    split_telemetry_record(tid, success, start);
+#endif
 }
 
 /////////
@@ -489,7 +511,7 @@ bool soft_serial_transaction(int sstd_index) {
 
     // initiator send phase
     if (trans->initiator2target_buffer_size > 0) {
-        serial_send_packet((uint8_t *)split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        serial_send_packet((uint8_t *)split_trans_initiator2target_buffer(trans), split_trans_initiator2target_length(trans));
     }
 
     // always, release the line when not in use
@@ -0,0 +1,41 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <avr/io.h>
+#include <util/atomic.h>
+#include "timer_avr.h"
+#include "task_profiler.h"
+
+extern volatile uint32_t timer_count;
+
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0A))
+#else
+#    define TIMER_COMPARE_PENDING() (TIFR0 & _BV(OCF0A))
+#endif
+
+// Timer0 runs in CTC mode, counting from 0 to TIMER_RAW_TOP once per millisecond.
+// Combine it with the millisecond counter to get a free-running timestamp.
+uint32_t task_profiler_ticks(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+        // With interrupts disabled (e.g. when called from an ISR) the millisecond counter can't have caught up yet.
+        // The compare flag is set once the timer reaches TOP, so re-reading the timer tells whether it has wrapped.
+        if (TIMER_COMPARE_PENDING()) {
+            raw = TIMER_RAW;
+            if (raw < TIMER_RAW_TOP) {
+                ++ms;
+            }
+        }
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+}
+
+uint32_t task_profiler_ticks_per_ms(void) {
+    return TIMER_RAW_TOP + 1;
+}
@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "timer.h"
+#include "tickless_idle.h"
+
+static volatile bool woken = false;
+
+void tickless_idle_sleep(uint32_t ms) {
+    uint32_t start = timer_read32();
+
+    // Idle mode keeps the timers and USB running -- the millisecond timer interrupt wakes the CPU at least once per tick
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (!woken && timer_elapsed32(start) < ms) {
+        cli();
+        if (!woken) {
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+        sei();
+    }
+    woken = false;
+}
+
+void tickless_idle_wake(void) {
+    woken = true;
+}
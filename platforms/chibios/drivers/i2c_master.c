@@ -149,19 +149,119 @@ __attribute__((weak)) void i2c_init(void) {
     }
 }
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 16
+#    endif
+#    ifndef I2C_ASYNC_TRANSFER_SIZE
+#        define I2C_ASYNC_TRANSFER_SIZE 32
+#    endif
+
+#    if I2C_ASYNC_QUEUE_SIZE > 255 || I2C_ASYNC_TRANSFER_SIZE > 254
+#        error I2C_ASYNC_QUEUE_SIZE and I2C_ASYNC_TRANSFER_SIZE must be less than 255
+#    endif
+
+typedef struct i2c_async_transfer_t {
+    uint8_t  address;
+    uint8_t  length;
+    uint8_t  attempts;
+    uint16_t timeout;
+    uint8_t  packet[I2C_ASYNC_TRANSFER_SIZE + 1];
+} i2c_async_transfer_t;
+
+// Writes are copied into the queue, so that callers are free to modify their buffers as soon as
+// the write has been queued. The head is only accessed by the worker thread, the tail by callers.
+static i2c_async_transfer_t  async_queue[I2C_ASYNC_QUEUE_SIZE];
+static uint8_t               async_head    = 0;
+static uint8_t               async_tail    = 0;
+static volatile uint8_t      async_pending = 0;
+static volatile i2c_status_t async_status  = I2C_STATUS_SUCCESS;
+static bool                  async_started = false;
+
+static SEMAPHORE_DECL(async_free, I2C_ASYNC_QUEUE_SIZE);
+static SEMAPHORE_DECL(async_queued, 0);
+static BSEMAPHORE_DECL(async_idle, true);
+
+/**
+ * @brief Transmits queued writes in the background. The thread sleeps while
+ * the peripheral, and its DMA channel if enabled, performs each transfer.
+ */
+static THD_WORKING_AREA(waI2CAsyncThread, 256);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&async_queued);
+
+        i2c_async_transfer_t* transfer = &async_queue[async_head];
+        i2c_status_t          status;
+        uint8_t               attempt = 0;
+        do {
+            i2cStart(&I2C_DRIVER, &i2cconfig);
+            status = i2c_epilogue(i2cMasterTransmitTimeout(&I2C_DRIVER, (transfer->address >> 1), transfer->packet, transfer->length, 0, 0, TIME_MS2I(transfer->timeout)));
+        } while (status != I2C_STATUS_SUCCESS && ++attempt < transfer->attempts);
+        async_head = (async_head + 1) % I2C_ASYNC_QUEUE_SIZE;
+
+        chSysLock();
+        if (status != I2C_STATUS_SUCCESS) {
+            async_status = status;
+        }
+        chSemSignalI(&async_free);
+        if (--async_pending == 0) {
+            chBSemSignalI(&async_idle);
+        }
+        chSchRescheduleS();
+        chSysUnlock();
+    }
+}
+
+bool i2c_async_busy(void) {
+    return async_pending > 0;
+}
+
+static void i2c_async_drain(void) {
+    chSysLock();
+    while (async_pending > 0) {
+        chBSemWaitS(&async_idle);
+    }
+    chSysUnlock();
+}
+
+// Reports a failed queued write once, to whoever asks first
+static i2c_status_t i2c_async_take_status(void) {
+    chSysLock();
+    i2c_status_t status = async_status;
+    async_status        = I2C_STATUS_SUCCESS;
+    chSysUnlock();
+    return status;
+}
+
+i2c_status_t i2c_async_wait(void) {
+    i2c_async_drain();
+    return i2c_async_take_status();
+}
+#else
+// Nothing is ever queued, synchronous transfers can start right away
+static inline void i2c_async_drain(void) {}
+#endif
+
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 1];
@@ -175,6 +275,7 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 2];
@@ -189,12 +290,14 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
@@ -207,4 +310,43 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     // This approach may produce false negative results for I2C devices that do not respond to a register 0 read request.
     uint8_t data = 0;
     return i2c_read_register(address, 0, &data, sizeof(data), timeout);
-}
\ No newline at end of file
+}
+
+#ifdef I2C_ASYNC_ENABLE
+i2c_status_t i2c_write_register_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, uint8_t attempts) {
+    if (length > I2C_ASYNC_TRANSFER_SIZE) {
+        i2c_status_t status;
+        uint8_t      attempt = 0;
+        do {
+            status = i2c_write_register(devaddr, regaddr, data, length, timeout);
+        } while (status != I2C_STATUS_SUCCESS && ++attempt < attempts);
+        i2c_status_t queued = i2c_async_take_status();
+        return queued != I2C_STATUS_SUCCESS ? queued : status;
+    }
+
+    if (!async_started) {
+        async_started = true;
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    }
+
+    // Only blocks once the queue is full
+    chSemWait(&async_free);
+
+    i2c_async_transfer_t* transfer = &async_queue[async_tail];
+    transfer->address              = devaddr;
+    transfer->length               = length + 1;
+    transfer->attempts             = attempts;
+    transfer->timeout              = timeout;
+    transfer->packet[0]            = regaddr;
+    memcpy(&transfer->packet[1], data, length);
+    async_tail = (async_tail + 1) % I2C_ASYNC_QUEUE_SIZE;
+
+    chSysLock();
+    ++async_pending;
+    chSemSignalI(&async_queued);
+    chSchRescheduleS();
+    chSysUnlock();
+
+    return i2c_async_take_status();
+}
+#endif
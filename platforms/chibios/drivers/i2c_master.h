@@ -24,6 +24,7 @@
  */
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 // ### DEPRECATED - DO NOT USE ###
@@ -47,3 +48,22 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
+
+#ifdef I2C_ASYNC_ENABLE
+/**
+ * Queues a register write, transmitted in the background while the caller carries on, and
+ * retried up to `attempts` times in total. The data is copied, writes longer than
+ * I2C_ASYNC_TRANSFER_SIZE are performed synchronously.
+ * Any other transfer first waits for the queued writes to complete.
+ *
+ * Returns the error of an earlier queued write that failed since the last time one was
+ * reported, if any, otherwise I2C_STATUS_SUCCESS.
+ */
+i2c_status_t i2c_write_register_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, uint8_t attempts);
+bool         i2c_async_busy(void);
+/**
+ * Waits for the queued writes to complete, returning the error of one that failed since the
+ * last time one was reported, if any.
+ */
+i2c_status_t i2c_async_wait(void);
+#endif
@@ -6,6 +6,9 @@
 #include "gpio.h"
 #include "wait.h"
 #include "synchronization_util.h"
+#ifdef SPLIT_TELEMETRY_ENABLE
+#    include "split_telemetry.h"
+#endif
 
 #include <hal.h>
 
@@ -155,6 +158,9 @@ static void __attribute__((noinline)) serial_write_byte(uint8_t data) {
 void interrupt_handler(void *arg) {
     split_shared_memory_lock_autounlock();
     chSysLockFromISR();
+#ifdef SPLIT_TELEMETRY_ENABLE
+    uint32_t start = split_telemetry_start();
+#endif
 
     sync_send();
 
@@ -168,14 +174,19 @@ void interrupt_handler(void *arg) {
     sync_send();
 
     split_transaction_desc_t *trans = &split_transaction_table[sstd_index];
-    for (int i = 0; i < trans->initiator2target_buffer_size; ++i) {
+    // Length prefixed buffers are cut short once their first byte has been received
+    for (int i = 0; i < split_trans_initiator2target_length(trans); ++i) {
         split_trans_initiator2target_buffer(trans)[i] = serial_read_byte();
         sync_send();
         checksum_computed += split_trans_initiator2target_buffer(trans)[i];
     }
     checksum_computed ^= 7;
 
+#ifdef SPLIT_TELEMETRY_ENABLE
+    bool success = serial_read_byte() == checksum_computed;
+#else
     serial_read_byte();
+#endif
     sync_send();
 
     // wait for the sync to finish sending
@@ -205,6 +216,9 @@ void interrupt_handler(void *arg) {
     // TODO: remove extra delay between transactions
     serial_delay();
 
+#ifdef SPLIT_TELEMETRY_ENABLE
+    split_telemetry_record(sstd_index, success, start);
+#endif
     chSysUnlockFromISR();
 }
 
@@ -245,7 +259,7 @@ static inline bool initiate_transaction(uint8_t sstd_index) {
     serial_write_byte(sstd_index); // first chunk is transaction id
     sync_recv();
 
-    for (int i = 0; i < trans->initiator2target_buffer_size; ++i) {
+    for (int i = 0; i < split_trans_initiator2target_length(trans); ++i) {
         serial_write_byte(split_trans_initiator2target_buffer(trans)[i]);
         sync_recv();
         checksum += split_trans_initiator2target_buffer(trans)[i];
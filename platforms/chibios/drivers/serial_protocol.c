@@ -1,14 +1,20 @@
 // Copyright 2022 Stefan Kerkmann
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <ch.h>
+#if !defined(SERIAL_USART_PIPELINED)
 
-#include "serial.h"
-#include "serial_protocol.h"
-#include "synchronization_util.h"
+#    include <ch.h>
+
+#    include "serial.h"
+#    include "serial_protocol.h"
+#    include "synchronization_util.h"
+#    ifdef SPLIT_TELEMETRY_ENABLE
+#        include "split_telemetry.h"
+#    endif
 
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
+static inline bool serve_transaction(uint8_t transaction_id);
 
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
@@ -57,9 +63,26 @@ static inline bool react_to_transaction(void) {
 
     /* Sanity check that we are actually responding to a valid transaction. */
     if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
+#    ifdef SPLIT_TELEMETRY_ENABLE
+        split_telemetry_record_invalid();
+#    endif
         return false;
     }
 
+#    ifdef SPLIT_TELEMETRY_ENABLE
+    uint32_t start   = split_telemetry_start();
+    bool     success = serve_transaction(transaction_id);
+    split_telemetry_record(transaction_id, success, start);
+    return success;
+#    else
+    return serve_transaction(transaction_id);
+#    endif
+}
+
+/**
+ * @brief Exchange the buffers of a transaction started by the master.
+ */
+static inline bool serve_transaction(uint8_t transaction_id) {
     split_shared_memory_lock_autounlock();
 
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
@@ -73,8 +96,22 @@ static inline bool react_to_transaction(void) {
 
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
-            return false;
+        uint8_t* buffer   = split_trans_initiator2target_buffer(transaction);
+        size_t   received = 0;
+
+        /* Length prefixed buffers tell how much of them is actually sent with their first byte. */
+        if (transaction->initiator2target_length_prefixed) {
+            if (unlikely(!serial_transport_receive(buffer, 1))) {
+                return false;
+            }
+            received = 1;
+        }
+
+        size_t length = split_trans_initiator2target_length(transaction);
+        if (length > received) {
+            if (unlikely(!serial_transport_receive(buffer + received, length - received))) {
+                return false;
+            }
         }
     }
 
@@ -140,7 +177,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), split_trans_initiator2target_length(transaction)))) {
             serial_dprintf("SPLIT: sending buffer failed\n");
             return false;
         }
@@ -156,3 +193,5 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+
+#endif // !defined(SERIAL_USART_PIPELINED)
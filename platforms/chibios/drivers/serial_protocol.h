@@ -40,6 +40,13 @@ bool __attribute__((nonnull, hot)) serial_transport_receive(uint8_t* destination
  */
 bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* destination, const size_t size);
 
+/**
+ * @brief Receive of up to size * bytes, waiting at most timeout_us for them. Only required by the pipelined protocol.
+ *
+ * @return size_t Number of bytes received, which is 0 on timeout.
+ */
+size_t __attribute__((nonnull, hot)) serial_transport_receive_timeout(uint8_t* destination, const size_t size, const uint32_t timeout_us);
+
 /**
  * @brief Blocking send of buffer with timeout.
  *
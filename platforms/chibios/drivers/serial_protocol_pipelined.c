@@ -0,0 +1,460 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#if defined(SERIAL_USART_PIPELINED)
+
+#    include <ch.h>
+#    include <string.h>
+
+#    include "serial_usart.h"
+#    include "serial_protocol.h"
+#    include "synchronization_util.h"
+#    include "crc.h"
+#    include "timer.h"
+#    ifdef SPLIT_TELEMETRY_ENABLE
+#        include "split_telemetry.h"
+#    endif
+
+/*
+    Pipelined full-duplex protocol.
+
+    Instead of the request/response transactions of serial_protocol.c, both halves send self-contained packets
+    whenever they have something to say:
+
+    - The master sends each transaction as a sequence numbered packet, without waiting for the slave. Up to
+      SERIAL_PIPELINE_WINDOW of these can be in flight. The slave only accepts them in order, acknowledging the last
+      one accepted in every packet it sends, and the master resends all unacknowledged packets when a resend is
+      requested or the acknowledgement takes longer than SERIAL_PIPELINE_RETRANSMIT_MS (go-back-N).
+    - The slave streams its half of the batch exchange (matrix, encoders, pointing device) unsolicited as soon as it
+      changes, and at least every SERIAL_PIPELINE_KEEPALIVE_MS. The master picks up the latest one on each scan.
+    - Transactions other than the batch exchange, i.e. RPCs, are answered with a response packet, which the master
+      waits for. The slave keeps its last response, and sends it again when the request is repeated -- which the
+      master does if the response hasn't arrived within SERIAL_PIPELINE_RETRANSMIT_MS of the request being
+      acknowledged.
+
+    Every packet is protected by a crc8. Whoever receives a corrupted packet sends a packet with the NAK flag set,
+    to have the other side resend. The SYNC flag is used to agree on the sequence numbers after either half resets:
+    the slave adopts the sequence number of a SYNC packet unless it lies within the window around the packets it
+    already accepted, in which case it is a retransmission. A freshly started master therefore waits for a packet
+    from the slave and continues half the sequence space away from the slave's last acknowledgement.
+*/
+
+#    if !defined(SERIAL_DRIVER_USART) || !defined(SERIAL_USART_FULL_DUPLEX) || !HAL_USE_SERIAL
+#        error "SERIAL_USART_PIPELINED requires the usart driver in full duplex mode, using the SERIAL subsystem"
+#    endif
+
+#    if !defined(SPLIT_TRANSACTION_BATCHING)
+#        error "SERIAL_USART_PIPELINED requires SPLIT_TRANSACTION_BATCHING"
+#    endif
+
+#    ifndef SERIAL_PIPELINE_WINDOW
+#        define SERIAL_PIPELINE_WINDOW 4
+#    endif // SERIAL_PIPELINE_WINDOW
+
+#    ifndef SERIAL_PIPELINE_PAYLOAD_SIZE
+#        define SERIAL_PIPELINE_PAYLOAD_SIZE 128
+#    endif // SERIAL_PIPELINE_PAYLOAD_SIZE
+
+#    ifndef SERIAL_PIPELINE_RETRANSMIT_MS
+#        define SERIAL_PIPELINE_RETRANSMIT_MS 5
+#    endif // SERIAL_PIPELINE_RETRANSMIT_MS
+
+#    ifndef SERIAL_PIPELINE_KEEPALIVE_MS
+#        define SERIAL_PIPELINE_KEEPALIVE_MS 5
+#    endif // SERIAL_PIPELINE_KEEPALIVE_MS
+
+#    ifndef SERIAL_PIPELINE_POLL_US
+#        define SERIAL_PIPELINE_POLL_US 100
+#    endif // SERIAL_PIPELINE_POLL_US
+
+#    define PIPELINE_START 0xA5
+#    define PIPELINE_FLAG_NAK 0x80
+#    define PIPELINE_FLAG_SYNC 0x40
+#    define PIPELINE_ID_MASK 0x1F
+
+typedef struct {
+    uint8_t start;
+    uint8_t id; // transaction ID and flags
+    uint8_t sequence;
+    uint8_t ack; // sequence number of the last packet accepted from the other half
+    uint8_t length;
+    uint8_t payload[SERIAL_PIPELINE_PAYLOAD_SIZE + 1]; // followed by the crc8
+} pipeline_packet_t;
+
+#    define PIPELINE_HEADER_SIZE offsetof(pipeline_packet_t, payload)
+
+_Static_assert((SERIAL_PIPELINE_WINDOW & (SERIAL_PIPELINE_WINDOW - 1)) == 0 && SERIAL_PIPELINE_WINDOW < 128, "SERIAL_PIPELINE_WINDOW must be a power of two below 128");
+_Static_assert(SERIAL_PIPELINE_PAYLOAD_SIZE <= UINT8_MAX, "SERIAL_PIPELINE_PAYLOAD_SIZE too large");
+_Static_assert(sizeof(split_batch_frame_t) <= SERIAL_PIPELINE_PAYLOAD_SIZE && sizeof(split_batch_reply_t) <= SERIAL_PIPELINE_PAYLOAD_SIZE, "SERIAL_PIPELINE_PAYLOAD_SIZE too small for the batch exchange");
+#    if defined(SPLIT_RPC_STREAMING)
+_Static_assert(sizeof(split_rpc_stream_frame_t) <= SERIAL_PIPELINE_PAYLOAD_SIZE, "SERIAL_PIPELINE_PAYLOAD_SIZE too small for SPLIT_RPC_STREAM_FRAME_SIZE");
+#    endif
+// The slave streams without being asked, so the master has to be able to buffer a couple of its packets between scans
+_Static_assert(SERIAL_BUFFERS_SIZE >= 2 * (PIPELINE_HEADER_SIZE + sizeof(split_batch_reply_t) + 1), "SERIAL_BUFFERS_SIZE too small, increase it in halconf.h");
+
+static pipeline_packet_t rx_packet;
+static uint8_t           rx_position = 0;
+
+typedef enum { PIPELINE_RX_NONE, PIPELINE_RX_PACKET, PIPELINE_RX_ERROR } pipeline_rx_t;
+
+static inline uint8_t pipeline_checksum(const pipeline_packet_t* packet) {
+    return crc8(&packet->id, PIPELINE_HEADER_SIZE - offsetof(pipeline_packet_t, id) + packet->length);
+}
+
+static bool pipeline_send(uint8_t id, uint8_t sequence, uint8_t ack, const uint8_t* payload, uint8_t length) {
+    pipeline_packet_t packet = {.start = PIPELINE_START, .id = id, .sequence = sequence, .ack = ack, .length = length};
+    if (length > 0) {
+        memcpy(packet.payload, payload, length);
+    }
+    packet.payload[length] = pipeline_checksum(&packet);
+    return serial_transport_send(&packet.start, PIPELINE_HEADER_SIZE + length + 1);
+}
+
+/**
+ * @brief Feeds received bytes to the packet parser, until a whole packet is in `rx_packet`.
+ *
+ * @param timeout_us How long to wait for each byte.
+ */
+static pipeline_rx_t pipeline_receive(uint32_t timeout_us) {
+    uint8_t* raw = &rx_packet.start;
+    uint8_t  byte;
+    while (serial_transport_receive_timeout(&byte, 1, timeout_us) == 1) {
+        /* Skip anything up to the start of the next packet. */
+        if (rx_position == 0 && byte != PIPELINE_START) {
+            continue;
+        }
+        raw[rx_position++] = byte;
+        if (rx_position < PIPELINE_HEADER_SIZE) {
+            continue;
+        }
+        if (unlikely(rx_packet.length > SERIAL_PIPELINE_PAYLOAD_SIZE)) {
+            rx_position = 0;
+            return PIPELINE_RX_ERROR;
+        }
+        if (rx_position < PIPELINE_HEADER_SIZE + rx_packet.length + 1) {
+            continue;
+        }
+        rx_position = 0;
+        return rx_packet.payload[rx_packet.length] == pipeline_checksum(&rx_packet) ? PIPELINE_RX_PACKET : PIPELINE_RX_ERROR;
+    }
+    return PIPELINE_RX_NONE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Slave
+
+typedef struct {
+    bool    valid;
+    uint8_t id;
+    uint8_t sequence;
+    uint8_t length;
+    uint8_t payload[SERIAL_PIPELINE_PAYLOAD_SIZE];
+} pipeline_response_t;
+
+static uint8_t             rx_expected = 0;
+static bool                rx_synced   = false;
+static pipeline_response_t last_response;
+
+static void pipeline_slave_send_response(void) {
+    pipeline_send(last_response.id, last_response.sequence, (uint8_t)(rx_expected - 1), last_response.payload, last_response.length);
+}
+
+/**
+ * @brief Acts on a packet from the master.
+ *
+ * @return bool Whether the slave should answer with its state.
+ */
+static bool pipeline_slave_handle_packet(bool* nak) {
+    uint8_t flags = rx_packet.id & ~PIPELINE_ID_MASK;
+    uint8_t id    = rx_packet.id & PIPELINE_ID_MASK;
+
+    /* The master didn't get our last packet intact. */
+    if (flags & PIPELINE_FLAG_NAK) {
+        return true;
+    }
+    if (unlikely(id >= NUM_TOTAL_TRANSACTIONS)) {
+        return false;
+    }
+    if (flags & PIPELINE_FLAG_SYNC) {
+        /* Retransmissions of the master's window still carry SYNC until it sees our acknowledgement. */
+        int8_t distance = (int8_t)(rx_packet.sequence - rx_expected);
+        if (!rx_synced || distance < -SERIAL_PIPELINE_WINDOW || distance >= SERIAL_PIPELINE_WINDOW) {
+            rx_expected         = rx_packet.sequence;
+            rx_synced           = true;
+            last_response.valid = false;
+        }
+    }
+
+    /* Only accept packets in order. Later ones mean that one got lost, earlier ones were already accepted. */
+    if (!rx_synced || rx_packet.sequence != rx_expected) {
+        if (rx_synced && (int8_t)(rx_packet.sequence - rx_expected) > 0) {
+            *nak = true;
+#    ifdef SPLIT_TELEMETRY_ENABLE
+            split_telemetry_record(id, false, split_telemetry_start());
+#    endif
+        } else if (last_response.valid && last_response.id == id && last_response.sequence == rx_packet.sequence) {
+            /* The master is still waiting for the response to a request that was already executed. */
+            pipeline_slave_send_response();
+            return false;
+        }
+        return true;
+    }
+    rx_expected++;
+#    ifdef SPLIT_TELEMETRY_ENABLE
+    uint32_t start = split_telemetry_start();
+#    endif
+
+    split_transaction_desc_t* transaction     = &split_transaction_table[id];
+    uint8_t                   response_length = transaction->target2initiator_buffer_size < sizeof(last_response.payload) ? transaction->target2initiator_buffer_size : sizeof(last_response.payload);
+
+    split_shared_memory_lock();
+    memcpy(split_trans_initiator2target_buffer(transaction), rx_packet.payload, rx_packet.length < transaction->initiator2target_buffer_size ? rx_packet.length : transaction->initiator2target_buffer_size);
+    if (transaction->slave_callback) {
+        transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+    }
+    if (id != EXCHANGE_BATCH) {
+        memcpy(last_response.payload, split_trans_target2initiator_buffer(transaction), response_length);
+    }
+    split_shared_memory_unlock();
+#    ifdef SPLIT_TELEMETRY_ENABLE
+    split_telemetry_record(id, true, start);
+#    endif
+
+    /* The batch exchange is answered by the state stream, anything else gets its own response. */
+    if (id == EXCHANGE_BATCH) {
+        return true;
+    }
+    last_response.valid    = true;
+    last_response.id       = id;
+    last_response.sequence = rx_packet.sequence;
+    last_response.length   = response_length;
+    pipeline_slave_send_response();
+    return false;
+}
+
+/**
+ * @brief This thread runs on the slave, it responds to the master's packets and streams the slave's state.
+ */
+static THD_WORKING_AREA(waSlaveThread, 1024);
+static THD_FUNCTION(SlaveThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_tx_rx");
+
+    split_transaction_desc_t* exchange   = &split_transaction_table[EXCHANGE_BATCH];
+    split_batch_reply_t       last_state = {0};
+    uint32_t                  last_sent  = 0;
+    uint8_t                   sequence   = 0;
+
+    while (true) {
+        bool          send_state = false;
+        bool          nak        = false;
+        pipeline_rx_t rx         = pipeline_receive(SERIAL_PIPELINE_POLL_US);
+        if (rx == PIPELINE_RX_PACKET) {
+            send_state = pipeline_slave_handle_packet(&nak);
+        } else if (rx == PIPELINE_RX_ERROR) {
+            send_state = nak = true;
+#    ifdef SPLIT_TELEMETRY_ENABLE
+            split_telemetry_record_invalid();
+#    endif
+        }
+
+        /* Refresh the state from what the slave handlers last left in shared memory. */
+        split_batch_reply_t state;
+        split_shared_memory_lock();
+        exchange->slave_callback(0, split_trans_initiator2target_buffer(exchange), exchange->target2initiator_buffer_size, split_trans_target2initiator_buffer(exchange));
+        memcpy(&state, split_trans_target2initiator_buffer(exchange), sizeof(state));
+        split_shared_memory_unlock();
+
+        if (send_state || memcmp(&state, &last_state, sizeof(state)) != 0 || timer_elapsed32(last_sent) >= SERIAL_PIPELINE_KEEPALIVE_MS) {
+            uint8_t flags = (nak ? PIPELINE_FLAG_NAK : 0) | (rx_synced ? 0 : PIPELINE_FLAG_SYNC);
+            pipeline_send(EXCHANGE_BATCH | flags, sequence++, (uint8_t)(rx_expected - 1), (const uint8_t*)&state, sizeof(state));
+            last_state = state;
+            last_sent  = timer_read32();
+        }
+    }
+}
+
+/**
+ * @brief Slave specific initializations.
+ */
+void soft_serial_target_init(void) {
+    serial_transport_driver_slave_init();
+
+    /* Start transport thread. */
+    chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Master
+
+typedef struct {
+    uint8_t id;
+    uint8_t length;
+    uint8_t payload[SERIAL_PIPELINE_PAYLOAD_SIZE];
+} pipeline_pending_t;
+
+static pipeline_pending_t tx_window[SERIAL_PIPELINE_WINDOW];
+static uint8_t            tx_base     = 0; // oldest unacknowledged sequence number
+static uint8_t            tx_next     = 0;
+static uint32_t           tx_timer    = 0;
+static bool               peer_synced = false;
+static bool               peer_seen   = false;
+static uint32_t           state_timer = 0;
+static bool               state_valid = false;
+
+static void pipeline_master_transmit(uint8_t sequence) {
+    pipeline_pending_t* pending = &tx_window[sequence % SERIAL_PIPELINE_WINDOW];
+    pipeline_send(pending->id | (peer_synced ? 0 : PIPELINE_FLAG_SYNC), sequence, 0, pending->payload, pending->length);
+}
+
+static void pipeline_master_retransmit(bool force) {
+    if (tx_base == tx_next || (!force && timer_elapsed32(tx_timer) < SERIAL_PIPELINE_RETRANSMIT_MS)) {
+        return;
+    }
+    for (uint8_t sequence = tx_base; sequence != tx_next; ++sequence) {
+        pipeline_master_transmit(sequence);
+    }
+    tx_timer = timer_read32();
+}
+
+static bool pipeline_master_queue(uint8_t id, const uint8_t* payload, uint8_t length) {
+    if ((uint8_t)(tx_next - tx_base) >= SERIAL_PIPELINE_WINDOW || length > SERIAL_PIPELINE_PAYLOAD_SIZE) {
+        serial_dprintf("SPLIT: pipeline full\n");
+        return false;
+    }
+    pipeline_pending_t* pending = &tx_window[tx_next % SERIAL_PIPELINE_WINDOW];
+    pending->id                 = id;
+    pending->length             = length;
+    memcpy(pending->payload, payload, length);
+    if (tx_base == tx_next) {
+        tx_timer = timer_read32();
+    }
+    pipeline_master_transmit(tx_next++);
+    return true;
+}
+
+/**
+ * @brief Handles all packets from the slave that have been received so far.
+ *
+ * @param response_id Transaction to pick up the response of, if any.
+ * @param response_sequence Sequence number of the request the response belongs to.
+ * @return bool Whether the response was received.
+ */
+static bool pipeline_master_poll(int response_id, uint8_t response_sequence, uint32_t timeout_us) {
+    bool          responded = false;
+    pipeline_rx_t rx;
+    while ((rx = pipeline_receive(timeout_us)) != PIPELINE_RX_NONE) {
+        if (rx == PIPELINE_RX_ERROR) {
+#    ifdef SPLIT_TELEMETRY_ENABLE
+            split_telemetry_record_invalid();
+#    endif
+            pipeline_send(EXCHANGE_BATCH | PIPELINE_FLAG_NAK, 0, 0, NULL, 0);
+            continue;
+        }
+
+        uint8_t flags = rx_packet.id & ~PIPELINE_ID_MASK;
+        uint8_t id    = rx_packet.id & PIPELINE_ID_MASK;
+        if (!peer_seen) {
+            /* Stay clear of the sequence numbers the slave may have accepted before we were reset. */
+            tx_base = tx_next = rx_packet.ack + 1 + 128;
+            peer_seen         = true;
+        }
+        if (flags & PIPELINE_FLAG_SYNC) {
+            /* The slave was reset, so it has to pick up our sequence numbers again. */
+            peer_synced = false;
+            pipeline_master_retransmit(true);
+        } else {
+            while (tx_base != tx_next && (uint8_t)(rx_packet.ack - tx_base) < (uint8_t)(tx_next - tx_base)) {
+                tx_base++;
+                tx_timer    = timer_read32();
+                peer_synced = true;
+            }
+            if (flags & PIPELINE_FLAG_NAK) {
+                pipeline_master_retransmit(true);
+            }
+        }
+
+        if (unlikely(id >= NUM_TOTAL_TRANSACTIONS)) {
+            continue;
+        }
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (id == EXCHANGE_BATCH) {
+            state_timer = timer_read32();
+            state_valid = true;
+        } else if (id != response_id || rx_packet.sequence != response_sequence) {
+            continue;
+        } else {
+            responded = true;
+        }
+        memcpy(split_trans_target2initiator_buffer(transaction), rx_packet.payload, rx_packet.length < transaction->target2initiator_buffer_size ? rx_packet.length : transaction->target2initiator_buffer_size);
+        if (responded) {
+            break;
+        }
+    }
+    return responded;
+}
+
+/**
+ * @brief Master specific initializations.
+ */
+void soft_serial_initiator_init(void) {
+    serial_transport_driver_master_init();
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction(int index) {
+    if (unlikely(index >= NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    split_transaction_desc_t* transaction = &split_transaction_table[index];
+    pipeline_master_poll(-1, 0, 0);
+
+    /* Nothing can be sent until the slave told us where to start. */
+    if (!peer_seen) {
+        return false;
+    }
+
+    /* The slave streams its state regardless, so batch frames without any data aren't worth sending. */
+    uint8_t sequence = tx_next;
+    if (index != EXCHANGE_BATCH || split_shmem->batch_frame.length > offsetof(split_batch_frame_t, data)) {
+        if (!pipeline_master_queue(index, split_trans_initiator2target_buffer(transaction), split_trans_initiator2target_length(transaction))) {
+            pipeline_master_retransmit(false);
+            return false;
+        }
+    }
+    pipeline_master_retransmit(false);
+
+    /* The batch exchange returns the latest state the slave streamed, as long as the slave is still there. */
+    if (index == EXCHANGE_BATCH) {
+        return state_valid && timer_elapsed32(state_timer) < SERIAL_USART_TIMEOUT;
+    }
+
+    /* Anything else waits for its response. */
+    uint32_t start     = timer_read32();
+    uint32_t requested = start;
+    while (!pipeline_master_poll(index, sequence, SERIAL_PIPELINE_POLL_US)) {
+        if (timer_elapsed32(start) >= SERIAL_USART_TIMEOUT) {
+            serial_dprintf("SPLIT: no response\n");
+            return false;
+        }
+        pipeline_master_retransmit(false);
+
+        /* Once the request is acknowledged its response got lost, so ask again to have the slave resend it. */
+        if ((uint8_t)(sequence - tx_base) >= (uint8_t)(tx_next - tx_base) && timer_elapsed32(requested) >= SERIAL_PIPELINE_RETRANSMIT_MS) {
+            pipeline_master_transmit(sequence);
+            requested = timer_read32();
+        }
+    }
+    return true;
+}
+
+#endif // defined(SERIAL_USART_PIPELINED)
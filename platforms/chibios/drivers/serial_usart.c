@@ -154,6 +154,10 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+inline size_t serial_transport_receive_timeout(uint8_t* destination, const size_t size, const uint32_t timeout_us) {
+    return chnReadTimeout(serial_driver, destination, size, timeout_us == 0 ? TIME_IMMEDIATE : TIME_US2I(timeout_us));
+}
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+#include "chibios_config.h"
+#include "task_profiler.h"
+
+uint32_t task_profiler_ticks(void) {
+#if PORT_SUPPORTS_RT == TRUE
+    return (uint32_t)chSysGetRealtimeCounterX();
+#else
+    // No cycle counter available (e.g. Cortex-M0), fall back to the system tick
+    return (uint32_t)chVTGetSystemTimeX();
+#endif
+}
+
+uint32_t task_profiler_ticks_per_ms(void) {
+#if PORT_SUPPORTS_RT == TRUE
+    return REALTIME_COUNTER_CLOCK / 1000;
+#else
+    return TIME_MS2I(1);
+#endif
+}
@@ -0,0 +1,18 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include "tickless_idle.h"
+
+// Signalled to end a sleep early. Whilst the main thread waits on it, the idle thread executes WFI.
+static BSEMAPHORE_DECL(wake_semaphore, true);
+
+void tickless_idle_sleep(uint32_t ms) {
+    chBSemWaitTimeout(&wake_semaphore, TIME_MS2I(ms));
+}
+
+void tickless_idle_wake(void) {
+    syssts_t sts = chSysGetStatusAndLockX();
+    chBSemSignalI(&wake_semaphore);
+    chSysRestoreStatusX(sts);
+}
@@ -0,0 +1,30 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "task_profiler.h"
+
+#ifdef TASK_PROFILER_HOST_CLOCK
+#    include <time.h>
+
+// Uses the host's monotonic clock in nanoseconds, for benchmarking real execution time.
+uint32_t task_profiler_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+
+uint32_t task_profiler_ticks_per_ms(void) {
+    return 1000000;
+}
+#else
+uint32_t timer_read_internal(void);
+
+// Uses the mocked timer, without side effects on the access counter, scaled to microseconds.
+uint32_t task_profiler_ticks(void) {
+    return timer_read_internal() * 1000;
+}
+
+uint32_t task_profiler_ticks_per_ms(void) {
+    return 1000;
+}
+#endif // TASK_PROFILER_HOST_CLOCK
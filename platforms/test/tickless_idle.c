@@ -0,0 +1,20 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+
+void advance_time(uint32_t ms);
+
+static bool woken = false;
+
+// Sleeping only moves the mocked timer forward, unless a wake up was requested beforehand.
+void tickless_idle_sleep(uint32_t ms) {
+    if (!woken) {
+        advance_time(ms);
+    }
+    woken = false;
+}
+
+void tickless_idle_wake(void) {
+    woken = true;
+}
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,16 +317,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Resolve layer
  *
- * Gets the layer based on key info
+ * Walks the given layer stack from the top to find the layer currently associated with the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t resolve_layer(layer_state_t layers, keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +337,63 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+#    define LAYER_LOOKUP_CACHE_UNRESOLVED 0xFF
+
+/** \brief layer lookup cache
+ *
+ * Resolved layer of each matrix key for the layer stack in layer_lookup_cache_state, filled in lazily
+ */
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_lookup_cache_state = 0;
+static bool          layer_lookup_cache_valid = false;
+
+/** \brief layer lookup cache invalidate
+ *
+ * Discards all resolved layers, must be called whenever the keymap changes
+ */
+void layer_lookup_cache_invalidate(void) {
+    layer_lookup_cache_valid = false;
+}
+
+/** \brief layer lookup cache get layer
+ *
+ * Looks up the resolved layer for the given layer stack and key, resolving it on a miss
+ */
+static uint8_t layer_lookup_cache_get_layer(layer_state_t layers, keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return resolve_layer(layers, key);
+    }
+
+    if (!layer_lookup_cache_valid || layers != layer_lookup_cache_state) {
+        memset(layer_lookup_cache, LAYER_LOOKUP_CACHE_UNRESOLVED, sizeof(layer_lookup_cache));
+        layer_lookup_cache_state = layers;
+        layer_lookup_cache_valid = true;
+    }
+
+    uint8_t *entry = &layer_lookup_cache[key.row][key.col];
+    if (*entry == LAYER_LOOKUP_CACHE_UNRESOLVED) {
+        *entry = resolve_layer(layers, key);
+    }
+    return *entry;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE
+    return layer_lookup_cache_get_layer(layers, key);
+#    else
+    return resolve_layer(layers, key);
+#    endif
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -163,6 +163,13 @@ uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+/* discard the resolved layers cached for each key, needed whenever the keymap changes */
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+void layer_lookup_cache_invalidate(void);
+#else
+#    define layer_lookup_cache_invalidate()
+#endif
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
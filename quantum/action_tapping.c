@@ -112,6 +112,22 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Next point in time at which the tapping state changes without further key events
+ *
+ * \return false if no tapping key is pending
+ */
+bool action_tapping_next_deadline(uint32_t *deadline) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return false;
+    }
+
+    uint32_t now     = timer_read32();
+    uint16_t elapsed = TIMER_DIFF_16((uint16_t)now, tapping_key.event.time);
+    uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    *deadline        = now + (elapsed < term ? term - elapsed : 0);
+    return true;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
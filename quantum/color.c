@@ -19,94 +19,75 @@
 #include "progmem.h"
 #include "util.h"
 
-RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
-    RGB      rgb;
-    uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
+// Source of the red, green and blue channels for each region of the hue circle, as indices into {v, p, q, t}
+static const uint8_t hsv_region_channels[7][3] PROGMEM = {
+    {0, 3, 1}, // red to yellow
+    {2, 0, 1}, // yellow to green
+    {1, 0, 3}, // green to cyan
+    {1, 2, 0}, // cyan to blue
+    {3, 1, 0}, // blue to magenta
+    {0, 1, 2}, // magenta to red
+    {0, 3, 1}, // red, hue 255 only
+};
 
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
-        return rgb;
-    }
+// Converts a single color, with the value already corrected for perceived brightness if required
+static inline RGB hsv_to_rgb_kernel(uint8_t h, uint8_t s, uint8_t v) {
+    RGB rgb;
 
-    h = hsv.h;
-    s = hsv.s;
-#ifdef USE_CIE1931_CURVE
-    if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
+    if (s == 0) {
+        rgb.r = v;
+        rgb.g = v;
+        rgb.b = v;
+        return rgb;
     }
-#else
-    v = hsv.v;
-#endif
 
-    region    = h * 6 / 255;
-    remainder = (h * 2 - region * 85) * 3;
+    // h * 6 / 255 without the division, exact for every hue
+    uint16_t h6        = h * 6;
+    uint8_t  region    = (h6 + (h6 >> 8) + 1) >> 8;
+    uint8_t  remainder = (h * 2 - region * 85) * 3;
 
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
-
-    switch (region) {
-        case 6:
-        case 0:
-            rgb.r = v;
-            rgb.g = t;
-            rgb.b = p;
-            break;
-        case 1:
-            rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
-            break;
-        case 2:
-            rgb.r = p;
-            rgb.g = v;
-            rgb.b = t;
-            break;
-        case 3:
-            rgb.r = p;
-            rgb.g = q;
-            rgb.b = v;
-            break;
-        case 4:
-            rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
-            break;
-        default:
-            rgb.r = v;
-            rgb.g = p;
-            rgb.b = q;
-            break;
-    }
+    uint8_t channels[4];
+    channels[0] = v;
+    channels[1] = (v * (255 - s)) >> 8;
+    channels[2] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    channels[3] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
 
+    rgb.r = channels[pgm_read_byte(&hsv_region_channels[region][0])];
+    rgb.g = channels[pgm_read_byte(&hsv_region_channels[region][1])];
+    rgb.b = channels[pgm_read_byte(&hsv_region_channels[region][2])];
     return rgb;
 }
 
-RGB hsv_to_rgb(HSV hsv) {
+static inline uint8_t hsv_to_rgb_cie(uint8_t v) {
 #ifdef USE_CIE1931_CURVE
-    return hsv_to_rgb_impl(hsv, true);
+    return pgm_read_byte(&CIE1931_CURVE[v]);
 #else
-    return hsv_to_rgb_impl(hsv, false);
+    return v;
 #endif
 }
 
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+    return hsv_to_rgb_kernel(hsv.h, hsv.s, use_cie ? hsv_to_rgb_cie(hsv.v) : hsv.v);
+}
+
+RGB hsv_to_rgb(HSV hsv) {
+    return hsv_to_rgb_kernel(hsv.h, hsv.s, hsv_to_rgb_cie(hsv.v));
+}
+
 RGB hsv_to_rgb_nocie(HSV hsv) {
-    return hsv_to_rgb_impl(hsv, false);
+    return hsv_to_rgb_kernel(hsv.h, hsv.s, hsv.v);
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, hsv_to_rgb_cie(hsv[i].v));
+    }
+}
+
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, hsv[i].v);
+    }
 }
 
 #ifdef WS2812_RGBW
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+// Converts every value of each hue and saturation in one batch, comparing against the single color conversion
+TEST(Color, HsvToRgbBatchMatchesSingle) {
+    HSV hsv[256];
+    RGB rgb[256];
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = (HSV){(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            hsv_to_rgb_batch(hsv, rgb, 256);
+            for (uint16_t v = 0; v < 256; v++) {
+                RGB expected = hsv_to_rgb(hsv[v]);
+                ASSERT_TRUE(rgb[v].r == expected.r && rgb[v].g == expected.g && rgb[v].b == expected.b) << "h=" << h << " s=" << s << " v=" << v;
+            }
+        }
+    }
+}
+
+TEST(Color, HsvToRgbNocieBatchMatchesSingle) {
+    HSV hsv[256];
+    RGB rgb[256];
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = (HSV){(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            hsv_to_rgb_nocie_batch(hsv, rgb, 256);
+            for (uint16_t v = 0; v < 256; v++) {
+                RGB expected = hsv_to_rgb_nocie(hsv[v]);
+                ASSERT_TRUE(rgb[v].r == expected.r && rgb[v].g == expected.g && rgb[v].b == expected.b) << "h=" << h << " s=" << s << " v=" << v;
+            }
+        }
+    }
+}
+
@@ -9,9 +9,21 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+#if MAX_DEFERRED_EXECUTORS > 255
+#    error MAX_DEFERRED_EXECUTORS must be less than 256
+#endif
+
 //------------------------------------
 // Helpers
 //
+// Each table is kept as a binary min-heap ordered by trigger time, so the next executor due is always at the front
+// of the schedule. Entries never move once claimed -- instead, the schedule is a permutation of the table's indices
+// spread across the `order` fields, with `position` being its inverse. Positions [0, count) of the schedule are the
+// pending executors, and [count, table_count) are the free entries, with recently freed ones at the back.
+//
+
+#define ENTRY_AT(table, pos) (&(table)[(table)[(pos)].order - 1])
+#define ENTRY_IS_USED(entry) ((entry)->callback != NULL)
 
 static deferred_token current_token = 0;
 
@@ -39,6 +51,109 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
     return current_token;
 }
 
+static inline size_t limit_table_count(size_t table_count) {
+    return table_count > UINT8_MAX ? UINT8_MAX : table_count;
+}
+
+static inline void init_table(deferred_executor_t *table, size_t table_count) {
+    if (table[0].order == 0) {
+        for (size_t i = 0; i < table_count; ++i) {
+            table[i].order    = i + 1;
+            table[i].position = i;
+        }
+    }
+}
+
+static uint8_t pending_count(deferred_executor_t *table, size_t table_count) {
+    // Pending executors always come first in the schedule, so binary search for the first free entry
+    size_t lo = 0;
+    size_t hi = table_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (ENTRY_IS_USED(ENTRY_AT(table, mid))) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static inline bool is_earlier(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    return ((int32_t)TIMER_DIFF_32(ENTRY_AT(table, a)->trigger_time, ENTRY_AT(table, b)->trigger_time)) < 0;
+}
+
+static inline void swap_positions(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    uint8_t order  = table[a].order;
+    table[a].order = table[b].order;
+    table[b].order = order;
+
+    ENTRY_AT(table, a)->position = a;
+    ENTRY_AT(table, b)->position = b;
+}
+
+static void sift_up(deferred_executor_t *table, size_t pos) {
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!is_earlier(table, pos, parent)) {
+            break;
+        }
+        swap_positions(table, pos, parent);
+        pos = parent;
+    }
+}
+
+static void sift_down(deferred_executor_t *table, size_t count, size_t pos) {
+    while (true) {
+        size_t child = 2 * pos + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && is_earlier(table, child + 1, child)) {
+            ++child;
+        }
+        if (!is_earlier(table, child, pos)) {
+            break;
+        }
+        swap_positions(table, pos, child);
+        pos = child;
+    }
+}
+
+static inline void reschedule(deferred_executor_t *table, size_t count, deferred_executor_t *entry) {
+    sift_up(table, entry->position);
+    sift_down(table, count, entry->position);
+}
+
+static inline deferred_executor_t *find_entry(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (ENTRY_IS_USED(entry) && entry->token == token) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void release_entry(deferred_executor_t *table, size_t table_count, deferred_executor_t *entry) {
+    uint8_t count = pending_count(table, table_count) - 1;
+    uint8_t pos   = entry->position;
+
+    // Swap the last pending executor into the hole, then clear the entry
+    swap_positions(table, pos, count);
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+    entry->lag          = 0;
+    if (pos < count) {
+        reschedule(table, count, ENTRY_AT(table, pos));
+    }
+
+    // Move the freed entry to the back of the free list, so that it isn't immediately reused
+    swap_positions(table, count, table_count - 1);
+}
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //
@@ -49,27 +164,31 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    table_count = limit_table_count(table_count);
+    init_table(table, table_count);
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Claim the first free entry, if any
+    uint8_t count = pending_count(table, table_count);
+    if (count >= table_count) {
+        // None available
+        return INVALID_DEFERRED_TOKEN;
     }
+    deferred_executor_t *entry = ENTRY_AT(table, count);
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, table_count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // Set up the executor table entry, and slot it into the schedule
+    entry->token        = token;
+    entry->trigger_time = timer_read32() + delay_ms;
+    entry->callback     = callback;
+    entry->cb_arg       = cb_arg;
+    entry->lag          = 0;
+    sift_up(table, count);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +198,18 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    table_count                = limit_table_count(table_count);
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    entry->lag          = 0;
+    reschedule(table, pending_count(table, table_count), entry);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +219,16 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    table_count                = limit_table_count(table_count);
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    release_entry(table, table_count, entry);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,40 +238,73 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
-            deferred_token       curr_token = entry->token;
+        if (!table || table_count == 0) {
+            return;
+        }
+        table_count = limit_table_count(table_count);
+        init_table(table, table_count);
+
+        // Run through the executors in order of trigger time, stopping at the first one not yet due
+        while (true) {
+            deferred_executor_t *entry = ENTRY_AT(table, 0);
+            if (!ENTRY_IS_USED(entry) || ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
 
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+            // Invoke the callback and work work out if we should be requeued
+            deferred_token curr_token = entry->token;
+            uint32_t       delay_ms   = entry->callback(entry->trigger_time - entry->lag, entry->cb_arg);
 
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
+            // If the token has changed, then the callback has canceled and possibly re-queued. Skip further processing.
+            if (!ENTRY_IS_USED(entry) || entry->token != curr_token) {
+                continue;
+            }
 
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
+            // Re-read the trigger time, as the callback may have extended itself
+            uint32_t trigger_time = entry->trigger_time - entry->lag;
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                trigger_time += delay_ms;
+                if (((int32_t)TIMER_DIFF_32(trigger_time, now)) <= 0) {
+                    // Still running behind -- hold off until the next pass so the other executors get their turn,
+                    // remembering how far back the intended trigger time was.
+                    uint32_t lag        = now + 1 - trigger_time;
+                    entry->lag          = lag > UINT8_MAX ? UINT8_MAX : lag;
+                    entry->trigger_time = now + 1;
                 } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    entry->lag          = 0;
+                    entry->trigger_time = trigger_time;
                 }
+                reschedule(table, pending_count(table, table_count), entry);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                release_entry(table, table_count, entry);
             }
         }
     }
 }
 
+bool deferred_exec_next_trigger_advanced(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || table_count == 0 || table[0].order == 0) {
+        return false;
+    }
+
+    // The front of the schedule is always the next one due
+    deferred_executor_t *entry = ENTRY_AT(table, 0);
+    if (!ENTRY_IS_USED(entry)) {
+        return false;
+    }
+    if (trigger_time) {
+        *trigger_time = entry->trigger_time;
+    }
+    return true;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -175,3 +324,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_next_trigger_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
@@ -65,6 +65,14 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Retrieves the time at which the next deferred executor is due, allowing the main loop to sleep until then.
+ *
+ * @param trigger_time[out] the intended trigger time of the next executor -- equivalent time-space as timer_read32()
+ * @return true if an executor is scheduled, otherwise false
+ */
+bool deferred_exec_next_trigger(uint32_t *trigger_time);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -73,9 +81,13 @@ void deferred_exec_task(void);
  * @struct Structure for containing self-hosted deferred executor tables.
  * @brief Core-side code can use this to create their own tables without impacting on the use of users' ability to add deferred execution.
  *        Code outside deferred_exec.c should not worry about internals of this struct, and should just allocate the required number in an array.
+ *        Tables must be zero-initialised, and may hold at most 255 entries.
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
+    uint8_t                order;    // 1 + index of the entry at this position of the schedule, 0 before first use
+    uint8_t                position; // position of this entry within the schedule
+    uint8_t                lag;      // milliseconds the trigger time was pushed back by, whilst running behind
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
@@ -119,3 +131,13 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Retrieves the time at which the next deferred executor in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the intended trigger time of the next executor -- equivalent time-space as timer_read32()
+ * @return true if an executor is scheduled, otherwise false
+ */
+bool deferred_exec_next_trigger_advanced(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
@@ -17,10 +17,12 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -97,6 +99,112 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
 #endif
 
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Everything from the keymap up to and including DYNAMIC_KEYMAP_EEPROM_MAX_ADDR is mirrored in RAM,
+// writes are only applied to the mirror and flushed to EEPROM from dynamic_keymap_task().
+#    define DYNAMIC_KEYMAP_RAM_CACHE_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR + 1)
+#    define DYNAMIC_KEYMAP_RAM_CACHE_MACRO_END (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - DYNAMIC_KEYMAP_EEPROM_ADDR)
+
+// Time to wait after the last write before flushing, so that bursts of writes from the host are batched
+#    ifndef DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY 100
+#    endif
+
+// Maximum number of bytes written to EEPROM per call to dynamic_keymap_task()
+#    ifndef DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_SIZE
+#        define DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_SIZE 32
+#    endif
+
+_Static_assert((DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) >= (DYNAMIC_KEYMAP_EEPROM_ADDR) && (DYNAMIC_KEYMAP_RAM_CACHE_MACRO_END) <= (DYNAMIC_KEYMAP_RAM_CACHE_SIZE), "Dynamic keymap RAM cache does not cover the macro buffer.");
+
+static uint8_t  ram_cache[DYNAMIC_KEYMAP_RAM_CACHE_SIZE];
+static bool     ram_cache_loaded = false;
+static uint16_t ram_cache_dirty_start = DYNAMIC_KEYMAP_RAM_CACHE_SIZE; // inclusive
+static uint16_t ram_cache_dirty_end   = 0;                             // exclusive
+static uint16_t ram_cache_last_write  = 0;
+
+static void ram_cache_load(void) {
+    // Also done on first access, as eeconfig may reset the keymap before dynamic_keymap_init() is called
+    if (!ram_cache_loaded) {
+        eeprom_read_block(ram_cache, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR), DYNAMIC_KEYMAP_RAM_CACHE_SIZE);
+        ram_cache_loaded = true;
+    }
+}
+
+static void ram_cache_mark_dirty(uint16_t start, uint16_t end) {
+    if (start < ram_cache_dirty_start) {
+        ram_cache_dirty_start = start;
+    }
+    if (end > ram_cache_dirty_end) {
+        ram_cache_dirty_end = end;
+    }
+    ram_cache_last_write = timer_read();
+}
+
+static void ram_cache_flush_chunk(uint16_t max_size) {
+    uint16_t size = ram_cache_dirty_end - ram_cache_dirty_start;
+    if (size > max_size) {
+        size = max_size;
+        // Flag the macro buffer as invalid until it has been completely flushed, in case the write
+        // gets interrupted -- the mirror holds the real value of the flag, which is written back last.
+        if (ram_cache_dirty_end > DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR) {
+            eeprom_update_byte((void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1), 0xFF);
+            ram_cache_dirty_end = DYNAMIC_KEYMAP_RAM_CACHE_MACRO_END > ram_cache_dirty_end ? DYNAMIC_KEYMAP_RAM_CACHE_MACRO_END : ram_cache_dirty_end;
+        }
+    }
+
+    eeprom_update_block(&ram_cache[ram_cache_dirty_start], (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + ram_cache_dirty_start), size);
+    ram_cache_dirty_start += size;
+    if (ram_cache_dirty_start >= ram_cache_dirty_end) {
+        ram_cache_dirty_start = DYNAMIC_KEYMAP_RAM_CACHE_SIZE;
+        ram_cache_dirty_end   = 0;
+    }
+}
+
+void dynamic_keymap_init(void) {
+    ram_cache_load();
+}
+
+void dynamic_keymap_task(void) {
+    if (ram_cache_dirty_start < ram_cache_dirty_end && timer_elapsed(ram_cache_last_write) >= DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY) {
+        ram_cache_flush_chunk(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_SIZE);
+    }
+}
+
+void dynamic_keymap_flush(void) {
+    if (ram_cache_dirty_start < ram_cache_dirty_end) {
+        ram_cache_flush_chunk(DYNAMIC_KEYMAP_RAM_CACHE_SIZE);
+    }
+}
+
+bool dynamic_keymap_is_dirty(void) {
+    return ram_cache_dirty_start < ram_cache_dirty_end;
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
+static uint8_t dynamic_keymap_read_byte(const void *address) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    ram_cache_load();
+    return ram_cache[(uintptr_t)address - DYNAMIC_KEYMAP_EEPROM_ADDR];
+#else
+    return eeprom_read_byte(address);
+#endif
+}
+
+static void dynamic_keymap_update_byte(void *address, uint8_t value) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    ram_cache_load();
+    uint16_t offset = (uintptr_t)address - DYNAMIC_KEYMAP_EEPROM_ADDR;
+    if (ram_cache[offset] == value) {
+        return;
+    }
+    ram_cache[offset] = value;
+    ram_cache_mark_dirty(offset, offset + 1);
+#else
+    eeprom_update_byte(address, value);
+#endif
+}
+
 #ifndef DYNAMIC_KEYMAP_MACRO_DELAY
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
@@ -114,8 +222,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -123,8 +231,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    layer_lookup_cache_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -136,8 +245,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -145,8 +254,8 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -165,15 +274,20 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // The EEPROM may have been erased behind the mirror's back (e.g. by eeconfig_init()), so write everything back
+    // rather than only what differs from the mirror
+    ram_cache_mark_dirty(0, DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR);
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -184,15 +298,16 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
     }
+    layer_lookup_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,11 +335,11 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -234,11 +349,11 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
@@ -249,9 +364,13 @@ void dynamic_keymap_macro_reset(void) {
     void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
     void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
-        eeprom_update_byte(p, 0);
+        dynamic_keymap_update_byte(p, 0);
         ++p;
     }
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // See dynamic_keymap_reset()
+    ram_cache_mark_dirty(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_RAM_CACHE_MACRO_END);
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
 }
 
 void dynamic_keymap_macro_send(uint8_t id) {
@@ -264,7 +383,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
     void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    if (dynamic_keymap_read_byte(p) != 0) {
         return;
     }
 
@@ -278,7 +397,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
         if (p == end) {
             return;
         }
-        if (eeprom_read_byte(p) == 0) {
+        if (dynamic_keymap_read_byte(p) == 0) {
             --id;
         }
         ++p;
@@ -289,7 +408,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_read_byte(p++);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -297,14 +416,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_read_byte(p++);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_read_byte(p++);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -316,7 +435,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_read_byte(p++);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
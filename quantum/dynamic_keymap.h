@@ -68,3 +68,14 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// With DYNAMIC_KEYMAP_RAM_CACHE, all of the above is served from a copy in RAM, loaded by dynamic_keymap_init().
+// Changes are written back to EEPROM in small chunks by dynamic_keymap_task(), once no further changes have been
+// made for DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY milliseconds. dynamic_keymap_flush() writes back all pending
+// changes immediately, and is called before the keyboard is reset.
+void dynamic_keymap_init(void);
+void dynamic_keymap_task(void);
+void dynamic_keymap_flush(void);
+bool dynamic_keymap_is_dirty(void);
+#endif
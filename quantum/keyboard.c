@@ -32,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "task_profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -101,6 +102,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef ST7565_ENABLE
 #    include "st7565.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
@@ -140,6 +144,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -371,8 +378,10 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
-    housekeeping_task_kb();
-    housekeeping_task_user();
+    TASK_PROFILER_CALL(TASK_PROFILER_HOUSEKEEPING_TASK, {
+        housekeeping_task_kb();
+        housekeeping_task_user();
+    });
 }
 
 /** \brief quantum_init
@@ -408,6 +417,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_CACHE)
+    dynamic_keymap_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -535,6 +547,9 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_scan_start();
+#endif
     matrix_scan();
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
@@ -569,7 +584,16 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
+#ifdef LATENCY_TRACE_ENABLE
+                    latency_trace_key_event((keypos_t){.row = row, .col = col}, key_pressed);
+#endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_MATRIX_EVENTS)
+                    keyevent_t event = MAKE_KEYEVENT(row, col, key_pressed);
+                    event.time       = split_matrix_event_time(row, col);
+                    action_exec(event);
+#else
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+#endif
                 }
 
                 switch_events(row, col, key_pressed);
@@ -659,27 +683,33 @@ void quantum_task(void) {
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+#ifdef TASK_PROFILER_ENABLE
+    const uint32_t task_profiler_start = task_profiler_ticks();
+#endif
+
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool                         matrix_changed        = false;
+    TASK_PROFILER_CALL(TASK_PROFILER_MATRIX_TASK, matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    TASK_PROFILER_CALL(TASK_PROFILER_QUANTUM_TASK, quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    TASK_PROFILER_CALL(TASK_PROFILER_RGBLIGHT_TASK, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    TASK_PROFILER_CALL(TASK_PROFILER_LED_MATRIX_TASK, led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    TASK_PROFILER_CALL(TASK_PROFILER_RGB_MATRIX_TASK, rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -689,14 +719,18 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_task()) {
+    bool encoder_changed = false;
+    TASK_PROFILER_CALL(TASK_PROFILER_ENCODER_TASK, encoder_changed = encoder_task());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed = false;
+    TASK_PROFILER_CALL(TASK_PROFILER_POINTING_DEVICE_TASK, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
@@ -748,4 +782,17 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_CACHE)
+    dynamic_keymap_task();
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task_end();
+#endif
+
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_record(TASK_PROFILER_KEYBOARD_TASK, task_profiler_ticks() - task_profiler_start);
+    task_profiler_task();
+#endif
 }
@@ -0,0 +1,220 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_trace.h"
+#include "task_profiler.h"
+#include "debug.h"
+#include "print.h"
+
+typedef struct latency_trace_pending_t {
+    keypos_t key;
+    bool     pressed;
+    bool     processed;
+    uint32_t scan;
+    uint32_t debounce;
+    uint32_t process;
+} latency_trace_pending_t;
+
+typedef struct latency_trace_accumulator_t {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+} latency_trace_accumulator_t;
+
+static latency_trace_pending_t pending[LATENCY_TRACE_PENDING_COUNT];
+static uint8_t                 pending_count = 0;
+
+static uint32_t scan_timestamp = 0;
+static uint32_t raw_timestamp  = 0;
+static bool     raw_pending    = false;
+static bool     raw_consumed   = false;
+
+static latency_trace_event_t events[LATENCY_TRACE_BUFFER_SIZE];
+static uint8_t               events_head  = 0;
+static uint8_t               events_count = 0;
+
+static latency_trace_accumulator_t accumulators[LATENCY_TRACE_STAGE_COUNT];
+static uint32_t                    dropped_count = 0;
+
+static const char *const stage_names[LATENCY_TRACE_STAGE_COUNT] = {
+    [LATENCY_TRACE_DEBOUNCE] = "debounce",
+    [LATENCY_TRACE_PROCESS]  = "process",
+    [LATENCY_TRACE_REPORT]   = "report",
+    [LATENCY_TRACE_TOTAL]    = "total",
+};
+
+static uint32_t ticks_to_us(uint32_t ticks) {
+    return (uint32_t)(((uint64_t)ticks * 1000) / task_profiler_ticks_per_ms());
+}
+
+static void accumulate(latency_trace_stage_t stage, uint32_t us) {
+    latency_trace_accumulator_t *acc = &accumulators[stage];
+    if (acc->count == 0 || us < acc->min) {
+        acc->min = us;
+    }
+    if (acc->count == 0 || us > acc->max) {
+        acc->max = us;
+    }
+    // Keep the running average meaningful instead of overflowing
+    if (acc->sum > UINT32_MAX - us) {
+        acc->sum /= 2;
+        acc->count /= 2;
+    }
+    acc->sum += us;
+    ++acc->count;
+}
+
+static void complete_event(const latency_trace_pending_t *p, uint32_t report) {
+    uint32_t debounce_us = ticks_to_us(p->debounce - p->scan);
+    uint32_t process_us  = ticks_to_us(p->process - p->debounce);
+    uint32_t report_us   = ticks_to_us(report - p->process);
+
+    accumulate(LATENCY_TRACE_DEBOUNCE, debounce_us);
+    accumulate(LATENCY_TRACE_PROCESS, process_us);
+    accumulate(LATENCY_TRACE_REPORT, report_us);
+    accumulate(LATENCY_TRACE_TOTAL, debounce_us + process_us + report_us);
+
+    latency_trace_event_t *event = &events[events_head];
+    event->key                   = p->key;
+    event->pressed               = p->pressed;
+    event->debounce_us           = debounce_us > UINT16_MAX ? UINT16_MAX : debounce_us;
+    event->process_us            = process_us > UINT16_MAX ? UINT16_MAX : process_us;
+    event->report_us             = report_us > UINT16_MAX ? UINT16_MAX : report_us;
+
+    if (++events_head >= LATENCY_TRACE_BUFFER_SIZE) {
+        events_head = 0;
+    }
+    if (events_count < LATENCY_TRACE_BUFFER_SIZE) {
+        ++events_count;
+    }
+}
+
+static void remove_pending(uint8_t index) {
+    memmove(&pending[index], &pending[index + 1], (pending_count - index - 1) * sizeof(latency_trace_pending_t));
+    --pending_count;
+}
+
+void latency_trace_scan_start(void) {
+    // Raw timestamps are shared by every event emitted during the scan they were consumed in
+    if (raw_consumed) {
+        raw_pending  = false;
+        raw_consumed = false;
+    }
+    scan_timestamp = task_profiler_ticks();
+}
+
+void latency_trace_raw_change(void) {
+    // Keep the earliest raw transition until the debounced matrix catches up
+    if (!raw_pending) {
+        raw_timestamp = task_profiler_ticks();
+        raw_pending   = true;
+    }
+}
+
+void latency_trace_key_event(keypos_t key, bool pressed) {
+    if (pending_count >= LATENCY_TRACE_PENDING_COUNT) {
+        remove_pending(0);
+        ++dropped_count;
+    }
+
+    latency_trace_pending_t *p = &pending[pending_count++];
+    p->key                     = key;
+    p->pressed                 = pressed;
+    p->processed               = false;
+    p->scan                    = raw_pending ? raw_timestamp : scan_timestamp;
+    p->debounce                = task_profiler_ticks();
+    p->process                 = 0;
+    raw_consumed               = raw_pending;
+}
+
+void latency_trace_processed(keypos_t key, bool pressed) {
+    for (uint8_t i = 0; i < pending_count; ++i) {
+        latency_trace_pending_t *p = &pending[i];
+        if (!p->processed && p->pressed == pressed && KEYEQ(p->key, key)) {
+            p->process   = task_profiler_ticks();
+            p->processed = true;
+            return;
+        }
+    }
+}
+
+void latency_trace_report_sent(void) {
+    uint32_t now = task_profiler_ticks();
+    uint8_t  i   = 0;
+    while (i < pending_count) {
+        if (pending[i].processed) {
+            complete_event(&pending[i], now);
+            remove_pending(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void latency_trace_task_end(void) {
+    // Whatever was processed during this pass but is still pending did not produce a report, so there is nothing
+    // left to measure -- waiting for an unrelated report would only attribute its delay to these events
+    uint8_t i = 0;
+    while (i < pending_count) {
+        if (pending[i].processed) {
+            remove_pending(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool latency_trace_get_stats(latency_trace_stage_t stage, latency_trace_stats_t *stats) {
+    if (stage >= LATENCY_TRACE_STAGE_COUNT || stats == NULL) {
+        return false;
+    }
+
+    const latency_trace_accumulator_t *acc = &accumulators[stage];
+    stats->count                           = acc->count;
+    stats->min_us                          = acc->min;
+    stats->max_us                          = acc->max;
+    stats->avg_us                          = acc->count ? acc->sum / acc->count : 0;
+    return true;
+}
+
+bool latency_trace_get_event(uint8_t index, latency_trace_event_t *event) {
+    if (index >= events_count || event == NULL) {
+        return false;
+    }
+
+    uint8_t slot = (events_head + LATENCY_TRACE_BUFFER_SIZE - 1 - index) % LATENCY_TRACE_BUFFER_SIZE;
+    *event       = events[slot];
+    return true;
+}
+
+const char *latency_trace_stage_name(latency_trace_stage_t stage) {
+    if (stage >= LATENCY_TRACE_STAGE_COUNT) {
+        return "unknown";
+    }
+    return stage_names[stage];
+}
+
+uint32_t latency_trace_dropped_count(void) {
+    return dropped_count;
+}
+
+void latency_trace_reset(void) {
+    pending_count = 0;
+    raw_pending   = false;
+    raw_consumed  = false;
+    events_head   = 0;
+    events_count  = 0;
+    dropped_count = 0;
+    memset(accumulators, 0, sizeof(accumulators));
+}
+
+void latency_trace_print(void) {
+    for (latency_trace_stage_t stage = 0; stage < LATENCY_TRACE_STAGE_COUNT; ++stage) {
+        latency_trace_stats_t stats;
+        latency_trace_get_stats(stage, &stats);
+        dprintf("latency %s -- n:%lu min:%luus avg:%luus max:%luus\n", latency_trace_stage_name(stage), stats.count, stats.min_us, stats.avg_us, stats.max_us);
+    }
+    dprintf("latency dropped: %lu\n", dropped_count);
+}
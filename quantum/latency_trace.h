@@ -0,0 +1,102 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+/*
+    Latency trace -- timestamps each key transition as it travels from the matrix to the host.
+
+    For every key event, the following points in time are captured:
+
+        scan:     the raw matrix first reported the transition (or the start of the matrix scan
+                  if the matrix implementation does not report raw changes)
+        debounce: the debounced matrix reported the transition to keyboard_task()
+        process:  the event reached process_record(), after any tapping delays
+        report:   the next keyboard report was handed to the host driver
+
+    Completed events are stored as deltas, in microseconds saturating at 65535, in a ring buffer of
+    the most recent LATENCY_TRACE_BUFFER_SIZE events, and aggregated into per-stage statistics.
+*/
+
+#ifndef LATENCY_TRACE_BUFFER_SIZE
+#    define LATENCY_TRACE_BUFFER_SIZE 32
+#endif
+
+#ifndef LATENCY_TRACE_PENDING_COUNT
+#    define LATENCY_TRACE_PENDING_COUNT 8
+#endif
+
+#if LATENCY_TRACE_BUFFER_SIZE > 255 || LATENCY_TRACE_PENDING_COUNT > 255
+#    error LATENCY_TRACE_BUFFER_SIZE and LATENCY_TRACE_PENDING_COUNT must be less than 256
+#endif
+
+typedef enum latency_trace_stage_t {
+    LATENCY_TRACE_DEBOUNCE, // scan -> debounce
+    LATENCY_TRACE_PROCESS,  // debounce -> process
+    LATENCY_TRACE_REPORT,   // process -> report
+    LATENCY_TRACE_TOTAL,    // scan -> report
+    LATENCY_TRACE_STAGE_COUNT,
+} latency_trace_stage_t;
+
+typedef struct latency_trace_event_t {
+    keypos_t key;
+    bool     pressed;
+    uint16_t debounce_us;
+    uint16_t process_us;
+    uint16_t report_us;
+} latency_trace_event_t;
+
+typedef struct latency_trace_stats_t {
+    uint32_t count;  // number of events aggregated
+    uint32_t min_us; // all-time minimum since the last reset
+    uint32_t avg_us; // running average since the last reset
+    uint32_t max_us; // all-time maximum since the last reset
+} latency_trace_stats_t;
+
+/**
+ * Hooks invoked by the core. Should not be invoked by keyboard/user code.
+ */
+void latency_trace_scan_start(void);
+void latency_trace_raw_change(void);
+void latency_trace_key_event(keypos_t key, bool pressed);
+void latency_trace_processed(keypos_t key, bool pressed);
+void latency_trace_report_sent(void);
+void latency_trace_task_end(void);
+
+/**
+ * Retrieves the aggregated statistics for the given stage.
+ *
+ * @return false if the stage is invalid
+ */
+bool latency_trace_get_stats(latency_trace_stage_t stage, latency_trace_stats_t *stats);
+
+/**
+ * Retrieves a completed event from the ring buffer, index 0 being the most recent one.
+ *
+ * @return false if there is no event at the given index
+ */
+bool latency_trace_get_event(uint8_t index, latency_trace_event_t *event);
+
+/**
+ * Human-readable name for the given stage.
+ */
+const char *latency_trace_stage_name(latency_trace_stage_t stage);
+
+/**
+ * Number of events discarded before completion as too many were in flight.
+ */
+uint32_t latency_trace_dropped_count(void);
+
+/**
+ * Clears all recorded events and statistics.
+ */
+void latency_trace_reset(void);
+
+/**
+ * Dumps the aggregated statistics to the console.
+ */
+void latency_trace_print(void);
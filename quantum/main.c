@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "task_profiler.h"
 
 void platform_setup(void);
 
@@ -69,9 +70,15 @@ int main(void) {
 #ifdef DEFERRED_EXEC_ENABLE
         // Run deferred executions
         void deferred_exec_task(void);
-        deferred_exec_task();
+        TASK_PROFILER_CALL(TASK_PROFILER_DEFERRED_EXEC_TASK, deferred_exec_task());
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef TICKLESS_IDLE_ENABLE
+        // Sleep until the next deadline
+        uint32_t tickless_idle_task(void);
+        tickless_idle_task();
+#endif // TICKLESS_IDLE_ENABLE
     }
 }
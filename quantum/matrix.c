@@ -31,6 +31,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define ROWS_PER_HAND (MATRIX_ROWS)
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef DIRECT_PINS_RIGHT
 #    define SPLIT_MUTABLE
 #else
@@ -270,6 +274,184 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_IDLE_SCANS
+// Once no key has been down for MATRIX_IDLE_SCANS scans, all outputs are selected at once so that any key press
+// shows up on the inputs. Scanning then only resumes once an input changes -- signalled by pin change interrupts
+// where available, otherwise by a single read of the inputs in place of each scan.
+#    if defined(PROTOCOL_CHIBIOS) && (PAL_USE_CALLBACKS == TRUE)
+#        define MATRIX_IDLE_INTERRUPTS
+#        define MATRIX_IDLE_EVENT_MODE (MATRIX_INPUT_PRESSED_STATE ? PAL_EVENT_MODE_RISING_EDGE : PAL_EVENT_MODE_FALLING_EDGE)
+#        ifdef TICKLESS_IDLE_ENABLE
+#            include "tickless_idle.h"
+#        endif
+#    endif
+
+#    if defined(DIRECT_PINS)
+#        define MATRIX_IDLE_INPUT_COUNT (ROWS_PER_HAND * MATRIX_COLS)
+#        define MATRIX_IDLE_INPUT_PIN(i) (direct_pins[(i) / MATRIX_COLS][(i) % MATRIX_COLS])
+#        define MATRIX_IDLE_SELECT_ALL()
+#        define MATRIX_IDLE_UNSELECT_ALL()
+#    elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_IDLE_INPUT_COUNT MATRIX_COLS
+#        define MATRIX_IDLE_INPUT_PIN(i) (col_pins[i])
+#        define MATRIX_IDLE_SELECT_ALL()                      \
+            do {                                              \
+                for (uint8_t x = 0; x < ROWS_PER_HAND; x++) { \
+                    select_row(x);                            \
+                }                                             \
+            } while (0)
+#        define MATRIX_IDLE_UNSELECT_ALL() unselect_rows()
+#    elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_IDLE_INPUT_COUNT ROWS_PER_HAND
+#        define MATRIX_IDLE_INPUT_PIN(i) (row_pins[i])
+#        define MATRIX_IDLE_SELECT_ALL()                    \
+            do {                                            \
+                for (uint8_t x = 0; x < MATRIX_COLS; x++) { \
+                    select_col(x);                          \
+                }                                           \
+            } while (0)
+#        define MATRIX_IDLE_UNSELECT_ALL() unselect_cols()
+#    else
+#        error MATRIX_IDLE_SCANS requires DIRECT_PINS, or MATRIX_ROW_PINS and MATRIX_COL_PINS
+#    endif
+
+static uint16_t      matrix_idle_scan_count = 0;
+static bool          matrix_idle            = false;
+static volatile bool matrix_idle_woken      = false;
+#    ifdef MATRIX_IDLE_INTERRUPTS
+static bool matrix_idle_interrupts = false;
+#    endif
+
+static bool matrix_idle_any_pressed(void) {
+    for (uint8_t i = 0; i < MATRIX_IDLE_INPUT_COUNT; i++) {
+        if (readMatrixPin(MATRIX_IDLE_INPUT_PIN(i)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#    ifdef MATRIX_IDLE_INTERRUPTS
+static void matrix_idle_callback(void *arg) {
+    matrix_idle_woken = true;
+#        ifdef TICKLESS_IDLE_ENABLE
+    tickless_idle_wake();
+#        endif
+}
+#    endif
+
+static void matrix_idle_init(void) {
+#    ifdef MATRIX_IDLE_INTERRUPTS
+    matrix_idle_interrupts = true;
+#        ifdef MCU_STM32
+    // STM32 has one EXTI line per pin number, shared by all ports -- arming two inputs with the same number leaves
+    // only the last one able to wake the matrix, so such layouts keep reading the inputs instead.
+    for (uint8_t i = 0; i < MATRIX_IDLE_INPUT_COUNT; i++) {
+        pin_t pin = MATRIX_IDLE_INPUT_PIN(i);
+        if (pin == NO_PIN) {
+            continue;
+        }
+        for (uint8_t j = i + 1; j < MATRIX_IDLE_INPUT_COUNT; j++) {
+            pin_t other = MATRIX_IDLE_INPUT_PIN(j);
+            if (other != NO_PIN && PAL_PAD(other) == PAL_PAD(pin)) {
+                matrix_idle_interrupts = false;
+                return;
+            }
+        }
+    }
+#        endif
+#    endif
+}
+
+static void matrix_idle_enter(void) {
+    MATRIX_IDLE_SELECT_ALL();
+    matrix_output_select_delay();
+
+#    ifdef MATRIX_IDLE_INTERRUPTS
+    if (matrix_idle_interrupts) {
+        matrix_idle_woken = false;
+        for (uint8_t i = 0; i < MATRIX_IDLE_INPUT_COUNT; i++) {
+            pin_t pin = MATRIX_IDLE_INPUT_PIN(i);
+            if (pin != NO_PIN) {
+                palEnableLineEvent(pin, MATRIX_IDLE_EVENT_MODE);
+                palSetLineCallback(pin, matrix_idle_callback, NULL);
+            }
+        }
+
+        // Catch any press that happened before the interrupts were armed
+        if (matrix_idle_any_pressed()) {
+            matrix_idle_woken = true;
+        }
+    }
+#    endif
+
+    matrix_idle = true;
+}
+
+static void matrix_idle_exit(void) {
+#    ifdef MATRIX_IDLE_INTERRUPTS
+    if (matrix_idle_interrupts) {
+        for (uint8_t i = 0; i < MATRIX_IDLE_INPUT_COUNT; i++) {
+            pin_t pin = MATRIX_IDLE_INPUT_PIN(i);
+            if (pin != NO_PIN) {
+                palDisableLineEvent(pin);
+            }
+        }
+    }
+#    endif
+
+    MATRIX_IDLE_UNSELECT_ALL();
+    matrix_output_unselect_delay(0, true);
+
+    matrix_idle            = false;
+    matrix_idle_scan_count = 0;
+}
+
+static bool matrix_idle_scan_needed(void) {
+    if (!matrix_idle) {
+        return true;
+    }
+
+#    ifdef MATRIX_IDLE_INTERRUPTS
+    bool woken = matrix_idle_interrupts ? matrix_idle_woken : matrix_idle_any_pressed();
+#    else
+    bool woken = matrix_idle_any_pressed();
+#    endif
+    if (!woken) {
+        return false;
+    }
+
+    matrix_idle_exit();
+    return true;
+}
+
+static void matrix_idle_update(matrix_row_t cooked[]) {
+    if (matrix_idle) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] || cooked[row]) {
+            matrix_idle_scan_count = 0;
+            return;
+        }
+    }
+
+    if (++matrix_idle_scan_count >= (MATRIX_IDLE_SCANS)) {
+        matrix_idle_enter();
+    }
+}
+
+bool matrix_idle_interrupt_armed(void) {
+#    if defined(MATRIX_IDLE_INTERRUPTS) && !defined(SPLIT_KEYBOARD)
+    return matrix_idle_interrupts && matrix_idle && !matrix_idle_woken;
+#    else
+    // Split keyboards still need to poll the other half
+    return false;
+#    endif
+}
+#endif // MATRIX_IDLE_SCANS
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -302,6 +484,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_IDLE_SCANS
+    matrix_idle_init();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -323,26 +508,42 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
+#ifdef MATRIX_IDLE_SCANS
+    // Whilst idle no key is down, matching the all-clear curr_matrix
+    if (matrix_idle_scan_needed())
+#endif
+    {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
-    }
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
 #elif (DIODE_DIRECTION == ROW2COL)
-    // Set col, read rows
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
-        matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
-    }
+        // Set col, read rows
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
+            matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+        }
 #endif
+    }
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
+#ifdef LATENCY_TRACE_ENABLE
+    if (changed) latency_trace_raw_change();
+#endif
+
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+#    ifdef MATRIX_IDLE_SCANS
+    matrix_idle_update(matrix + thisHand);
+#    endif
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifdef MATRIX_IDLE_SCANS
+    matrix_idle_update(matrix);
+#    endif
     matrix_scan_kb();
 #endif
     return (uint8_t)changed;
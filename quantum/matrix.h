@@ -65,6 +65,11 @@ void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
 
+#ifdef MATRIX_IDLE_SCANS
+/* whether the matrix is idle and waiting for a pin change interrupt, rather than needing to be scanned */
+bool matrix_idle_interrupt_armed(void);
+#endif
+
 /* power control */
 void matrix_power_up(void);
 void matrix_power_down(void);
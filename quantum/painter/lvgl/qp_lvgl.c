@@ -146,3 +146,10 @@ void qp_lvgl_internal_tick(void) {
     static uint32_t last_lvgl_exec = 0;
     deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_internal_next_trigger
+
+bool qp_lvgl_internal_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_next_trigger_advanced(lvgl_executors, 2, trigger_time);
+}
@@ -56,6 +56,24 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of glyphs kept in RAM, already decoded to the native pixel format of the display they
+ *      were drawn to. Text drawn with cached glyphs skips reading the font entirely, and adjacent cached glyphs are sent
+ *      to the display in one go. Each entry requires \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of RAM. Defaults
+ *      to 0, which disables the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the maximum size, in bytes, of a single decoded glyph in the glyph cache. Glyphs that don't fit
+ *      are drawn directly from the font instead. A 12x16 glyph requires 384 bytes on a 16bpp display.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 256
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -51,8 +51,12 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
 // Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
 void qp_internal_invalidate_palette(void);
 
-// Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
-bool qp_internal_load_qgf_palette(qp_stream_t* stream, uint8_t bpp);
+// Drops any glyphs cached for the device. Needed whenever the native pixel values the device was using change meaning, such as a palette surface being reset.
+void qp_internal_invalidate_glyph_cache(painter_device_t device);
+
+// Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset, converted to the device's native format. Expects the stream to be positioned at the start of the block header.
+// Conversion is skipped if the lookup table already holds the same palette for the same device.
+bool qp_internal_load_qgf_palette(painter_device_t device, qp_stream_t* stream, uint8_t bpp);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter codec functions
@@ -71,7 +75,7 @@ typedef struct qp_internal_byte_input_state_t {
         // RLE-specific
         struct {
             enum qp_internal_rle_mode_t mode;
-            uint8_t                     remain; // number of bytes remaining in the current mode
+            uint16_t                    remain; // number of bytes remaining in the current mode
         } rle;
     };
 } qp_internal_byte_input_state_t;
@@ -92,9 +96,12 @@ typedef struct qp_internal_byte_output_state_t {
 
 bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 
+// Reads the next `byte_count` decoded bytes in one go, decoding whole runs at a time where the input callback allows it
+bool qp_internal_read_bytes(qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* buffer, uint32_t byte_count);
+
 // Helper shared between image and font rendering, sends pixels to the display using:
-//     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
-//     - qp_internal_send_bytes                                  (bpp > 8)
+//     - qp_internal_read_bytes, unpacked in chunks to append_pixels (bpp <= 8)
+//     - qp_internal_send_bytes                                     (bpp > 8)
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
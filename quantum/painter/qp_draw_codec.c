@@ -84,46 +84,120 @@ bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_int
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Progressive pull of bytes, push of pixels
 
-static inline int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
+static int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
     qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
     state->curr                           = qp_stream_get(state->src_stream);
     return state->curr;
 }
 
-static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
-    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
+// Parses an RLE marker byte, setting up the mode and length of the next run
+static inline bool qp_drawimage_rle_read_marker(qp_internal_byte_input_state_t* state, bool block_rle) {
+    int16_t c = qp_stream_get(state->src_stream);
+    if (c < 0) {
+        return false;
+    }
 
-    // Work out if we're parsing the initial marker byte
-    if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
-        if (c >= 128) {
-            state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
-            state->rle.remain = c - 127;
-        } else {
-            state->rle.mode   = REPEATING_RUN; // repeated run
-            state->rle.remain = c;
+    if (block_rle) {
+        // Block RLE: bit 7 denotes a non-repeating run, bit 6 denotes a second length byte, lengths are stored minus one
+        uint16_t length = c & 0x3F;
+        if (c & 0x40) {
+            int16_t lo = qp_stream_get(state->src_stream);
+            if (lo < 0) {
+                return false;
+            }
+            length = (length << 8) | lo;
         }
+        state->rle.mode   = (c & 0x80) ? NON_REPEATING_RUN : REPEATING_RUN;
+        state->rle.remain = length + 1;
+    } else if (c >= 128) {
+        state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
+        state->rle.remain = c - 127;
+    } else {
+        state->rle.mode   = REPEATING_RUN; // repeated run
+        state->rle.remain = c;
+    }
 
+    // Repeated runs only have the one byte following the marker
+    if (state->rle.mode == REPEATING_RUN) {
         state->curr = qp_stream_get(state->src_stream);
+        if (state->curr < 0) {
+            return false;
+        }
     }
 
-    // Work out which byte we're returning
-    uint8_t c = state->curr;
+    return state->rle.remain > 0;
+}
 
-    // Decrement the counter of the bytes remaining
-    state->rle.remain--;
+static inline int16_t qp_drawimage_rle_next_byte(qp_internal_byte_input_state_t* state, bool block_rle) {
+    // Work out if we're parsing the initial marker byte
+    if (state->rle.mode == MARKER_BYTE && !qp_drawimage_rle_read_marker(state, block_rle)) {
+        return STREAM_EOF;
+    }
 
-    if (state->rle.remain > 0) {
-        // If we're in a non-repeating run, queue up the next byte
-        if (state->rle.mode == NON_REPEATING_RUN) {
-            state->curr = qp_stream_get(state->src_stream);
-        }
-    } else {
-        // Swap back to querying the marker byte mode
+    // Non-repeating runs pull each byte from the stream as they're needed
+    if (state->rle.mode == NON_REPEATING_RUN) {
+        state->curr = qp_stream_get(state->src_stream);
+    }
+
+    // Decrement the counter of the bytes remaining, swapping back to querying the marker byte once the run is done
+    if (--state->rle.remain == 0) {
         state->rle.mode = MARKER_BYTE;
     }
 
-    return c;
+    return state->curr;
+}
+
+static int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
+    return qp_drawimage_rle_next_byte((qp_internal_byte_input_state_t*)cb_arg, false);
+}
+
+static int16_t qp_drawimage_byte_block_rle_decoder(void* cb_arg) {
+    return qp_drawimage_rle_next_byte((qp_internal_byte_input_state_t*)cb_arg, true);
+}
+
+// Decodes entire runs at a time -- repeated runs are filled in directly, non-repeating runs are read straight from the stream
+static bool qp_drawimage_rle_read_bytes(qp_internal_byte_input_state_t* state, bool block_rle, uint8_t* buffer, uint32_t byte_count) {
+    while (byte_count > 0) {
+        if (state->rle.mode == MARKER_BYTE && !qp_drawimage_rle_read_marker(state, block_rle)) {
+            return false;
+        }
+
+        uint16_t length = QP_MIN(state->rle.remain, byte_count);
+        if (state->rle.mode == REPEATING_RUN) {
+            memset(buffer, state->curr, length);
+        } else if (qp_stream_read(buffer, 1, length, state->src_stream) != length) {
+            return false;
+        }
+
+        buffer += length;
+        byte_count -= length;
+        state->rle.remain -= length;
+        if (state->rle.remain == 0) {
+            state->rle.mode = MARKER_BYTE;
+        }
+    }
+    return true;
+}
+
+bool qp_internal_read_bytes(qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* buffer, uint32_t byte_count) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)input_state;
+    if (input_callback == qp_drawimage_byte_uncompressed_decoder) {
+        return qp_stream_read(buffer, 1, byte_count, state->src_stream) == byte_count;
+    } else if (input_callback == qp_drawimage_byte_rle_decoder) {
+        return qp_drawimage_rle_read_bytes(state, false, buffer, byte_count);
+    } else if (input_callback == qp_drawimage_byte_block_rle_decoder) {
+        return qp_drawimage_rle_read_bytes(state, true, buffer, byte_count);
+    }
+
+    // Unknown decoder, fall back to pulling a byte at a time
+    for (uint32_t i = 0; i < byte_count; ++i) {
+        int16_t byteval = input_callback(input_state);
+        if (byteval < 0) {
+            return false;
+        }
+        buffer[i] = byteval;
+    }
+    return true;
 }
 
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
@@ -165,7 +239,58 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
+// Number of palette indices decoded at a time by qp_internal_appender
+#define QP_INTERNAL_APPENDER_CHUNK_PIXELS 64
+
+static inline void qp_internal_store_indices(uint8_t* indices, uint32_t value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(indices, &value, sizeof(value));
+#else
+    indices[0] = value;
+    indices[1] = value >> 8;
+    indices[2] = value >> 16;
+    indices[3] = value >> 24;
+#endif
+}
+
+// Spreads the 4 low bits of the nibble across the 4 bytes of the word, one palette index each
+static inline uint32_t qp_internal_spread_1bpp(uint8_t nibble) {
+    uint32_t x = nibble;
+    x          = (x | (x << 14)) & 0x00030003;
+    return (x | (x << 7)) & 0x01010101;
+}
+
+// Spreads the 4 2-bit values of the byte across the 4 bytes of the word, one palette index each
+static inline uint32_t qp_internal_spread_2bpp(uint8_t byteval) {
+    uint32_t x = byteval;
+    x          = (x | (x << 12)) & 0x000F000F;
+    return (x | (x << 6)) & 0x03030303;
+}
+
+// Unpacks LSb-first packed 1/2/4bpp pixel data into one palette index per byte
+static void qp_internal_unpack_indices(uint8_t* indices, const uint8_t* packed, uint8_t byte_count, uint8_t bpp) {
+    switch (bpp) {
+        case 1:
+            for (uint8_t i = 0; i < byte_count; ++i, indices += 8) {
+                qp_internal_store_indices(&indices[0], qp_internal_spread_1bpp(packed[i] & 0x0F));
+                qp_internal_store_indices(&indices[4], qp_internal_spread_1bpp(packed[i] >> 4));
+            }
+            break;
+        case 2:
+            for (uint8_t i = 0; i < byte_count; ++i, indices += 4) {
+                qp_internal_store_indices(indices, qp_internal_spread_2bpp(packed[i]));
+            }
+            break;
+        case 4:
+            for (uint8_t i = 0; i < byte_count; ++i, indices += 2) {
+                indices[0] = packed[i] & 0x0F;
+                indices[1] = packed[i] >> 4;
+            }
+            break;
+    }
+}
+
+// Helper shared between image and font rendering -- uses either palette index unpacking or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
@@ -173,14 +298,50 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
 
     // Non-native pixel format
     if (bpp <= 8) {
-        // Set up the output state
-        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+        // The palette has already been converted to the panel's native format, so pixels are decoded in chunks of
+        // palette indices and handed to the driver a chunk at a time, rather than one pixel at a time
+        const uint8_t  pixels_per_byte = 8 / bpp;
+        const uint32_t max_pixels      = qp_internal_num_pixels_in_buffer(device);
+        uint32_t       write_pos       = 0;
+        uint8_t        packed[QP_INTERNAL_APPENDER_CHUNK_PIXELS / 2];
+        uint8_t        indices[QP_INTERNAL_APPENDER_CHUNK_PIXELS];
+
+        ret = true;
+        while (ret && pixel_count > 0) {
+            // Pull in the next lot of packed pixel data, and unpack it to palette indices
+            uint8_t byte_count  = QP_MIN((pixel_count + pixels_per_byte - 1) / pixels_per_byte, QP_INTERNAL_APPENDER_CHUNK_PIXELS / pixels_per_byte);
+            uint8_t index_count = QP_MIN(pixel_count, (uint32_t)byte_count * pixels_per_byte);
+            if (!qp_internal_read_bytes(input_callback, input_state, bpp == 8 ? indices : packed, byte_count)) {
+                ret = false;
+                break;
+            }
+            if (bpp < 8) {
+                qp_internal_unpack_indices(indices, packed, byte_count, bpp);
+            }
+            pixel_count -= index_count;
+
+            // Convert the indices to native pixels, transmitting whenever the buffer is full
+            for (uint8_t offset = 0; offset < index_count;) {
+                uint32_t count = QP_MIN(index_count - offset, max_pixels - write_pos);
+                if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, write_pos, count, &indices[offset])) {
+                    ret = false;
+                    break;
+                }
+                offset += count;
+                write_pos += count;
+                if (write_pos == max_pixels) {
+                    if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, write_pos)) {
+                        ret = false;
+                        break;
+                    }
+                    write_pos = 0;
+                }
+            }
+        }
 
-        // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
         // Any leftovers need transmission as well.
-        if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+        if (ret && write_pos > 0) {
+            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, write_pos);
         }
     }
 
@@ -212,6 +373,10 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             input_state->rle.mode   = MARKER_BYTE;
             input_state->rle.remain = 0;
             return qp_drawimage_byte_rle_decoder;
+        case IMAGE_COMPRESSED_BLOCK_RLE:
+            input_state->rle.mode   = MARKER_BYTE;
+            input_state->rle.remain = 0;
+            return qp_drawimage_byte_block_rle_decoder;
         default:
             return NULL;
     }
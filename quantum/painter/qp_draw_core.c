@@ -27,6 +27,12 @@ static bool                                       generated_palette = false;
 static int16_t                                    generated_steps   = -1;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_fg_hsv888;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_bg_hsv888;
+
+// Checksum of the palette last loaded from an asset, and the device it was converted for
+static bool             loaded_palette         = false;
+static painter_device_t loaded_palette_device  = NULL;
+static uint16_t         loaded_palette_entries = 0;
+static uint32_t         loaded_palette_checksum;
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[256];
 #else
@@ -59,8 +65,20 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
 
     // Append the required number of pixels
     uint8_t palette_idx = 0;
-    for (uint32_t i = 0; i < num_pixels; ++i) {
-        driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, &color, i, 1, &palette_idx);
+    if (num_pixels == 0 || driver->native_bits_per_pixel % 8 != 0) {
+        for (uint32_t i = 0; i < num_pixels; ++i) {
+            driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, &color, i, 1, &palette_idx);
+        }
+        return;
+    }
+
+    // Whole bytes per pixel, so the first pixel can be replicated by doubling up the filled part of the buffer
+    uint32_t bytes_per_pixel = driver->native_bits_per_pixel / 8;
+    driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, &color, 0, 1, &palette_idx);
+    for (uint32_t filled = 1; filled < num_pixels;) {
+        uint32_t count = QP_MIN(filled, num_pixels - filled);
+        memcpy(&qp_internal_global_pixdata_buffer[filled * bytes_per_pixel], qp_internal_global_pixdata_buffer, count * bytes_per_pixel);
+        filled += count;
     }
 }
 
@@ -68,6 +86,7 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
 void qp_internal_invalidate_palette(void) {
     generated_palette = false;
     generated_steps   = -1;
+    loaded_palette    = false;
 }
 
 // Interpolates between two colors to generate a palette
@@ -79,7 +98,8 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
         return false;
     }
 
-    // Save the parameters so we know whether we can skip generation
+    // Save the parameters so we know whether we can skip generation, the lookup table no longer holds a loaded palette
+    loaded_palette         = false;
     generated_palette      = true;
     generated_steps        = steps;
     interpolated_fg_hsv888 = fg_hsv888;
@@ -107,8 +127,10 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
     return true;
 }
 
-// Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
-bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
+// Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset, converted to the device's native format. Expects the stream to be positioned at the start of the block header.
+bool qp_internal_load_qgf_palette(painter_device_t device, qp_stream_t *stream, uint8_t bpp) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
     qgf_palette_v1_t palette_descriptor;
     if (qp_stream_read(&palette_descriptor, sizeof(qgf_palette_v1_t), 1, stream) != 1) {
         qp_dprintf("Failed to read palette_descriptor, expected length was not %d\n", (int)sizeof(qgf_palette_v1_t));
@@ -117,11 +139,34 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
 
     // BPP determines the number of palette entries, each entry is a HSV888 triplet.
     const uint16_t palette_entries = 1u << bpp;
+    const int32_t  palette_start   = qp_stream_tell(stream);
+
+    // Checksum the palette first -- animation frames frequently share the same palette, and reading it is far cheaper
+    // than converting it all over again
+    uint32_t checksum = 2166136261u;
+    for (uint16_t remaining = palette_entries * sizeof(qgf_palette_entry_v1_t); remaining > 0;) {
+        uint8_t  chunk[24];
+        uint16_t count = QP_MIN(remaining, sizeof(chunk));
+        if (qp_stream_read(chunk, 1, count, stream) != count) {
+            return false;
+        }
+        for (uint16_t i = 0; i < count; ++i) {
+            checksum = (checksum ^ chunk[i]) * 16777619u;
+        }
+        remaining -= count;
+    }
+
+    // Leave the lookup table as-is if it already holds this palette, converted for this device
+    if (loaded_palette && loaded_palette_device == device && loaded_palette_entries == palette_entries && loaded_palette_checksum == checksum) {
+        qp_dprintf("qp_internal_load_qgf_palette: reusing palette\n");
+        return true;
+    }
 
     // Ensure we aren't reusing any palette
     qp_internal_invalidate_palette();
 
     // Read the palette entries
+    qp_stream_setpos(stream, palette_start);
     for (uint16_t i = 0; i < palette_entries; ++i) {
         // Read the palette entry
         qgf_palette_entry_v1_t entry;
@@ -137,6 +182,16 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
         qp_dprintf("qp_internal_load_qgf_palette: %3d of %d -- H: %3d, S: %3d, V: %3d\n", (int)(i + 1), (int)palette_entries, (int)qp_internal_global_pixel_lookup_table[i].hsv888.h, (int)qp_internal_global_pixel_lookup_table[i].hsv888.s, (int)qp_internal_global_pixel_lookup_table[i].hsv888.v);
     }
 
+    // Convert the palette to native format
+    if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
+        qp_dprintf("qp_internal_load_qgf_palette: fail (could not convert pixels to native)\n");
+        return false;
+    }
+
+    loaded_palette          = true;
+    loaded_palette_device   = device;
+    loaded_palette_entries  = palette_entries;
+    loaded_palette_checksum = checksum;
     return true;
 }
 
@@ -122,11 +122,12 @@ typedef struct qgf_frame_info_t {
     uint16_t              right;
     uint16_t              bottom;
     uint16_t              delay;
+    uint32_t              palette_offset; // Stream position of the palette block, if the frame has one
+    uint32_t              data_offset;    // Stream position of the pixel data
 } qgf_frame_info_t;
 
-static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
-    painter_driver_t *driver = (painter_driver_t *)device;
-
+// Parses the frame's blocks, recording where its palette and pixel data are located -- doesn't touch the palette or the device
+static bool qp_drawimage_read_frame_info(qgf_image_handle_t *qgf_image, uint16_t frame_number, qgf_frame_info_t *info) {
     // Drop out if we can't actually place the data we read out anywhere
     if (!info) {
         qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
@@ -148,39 +149,10 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Ensure we aren't reusing any palette
-    qp_internal_invalidate_palette();
-
-    if (!qp_internal_bpp_capable(info->bpp)) {
-        qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
-        qp_comms_stop(device);
-        return false;
-    }
-
-    // Handle palette if needed
-    const uint16_t palette_entries  = 1u << info->bpp;
-    bool           needs_pixconvert = false;
+    // Skip over the palette, it's loaded once the frame is actually drawn
     if (info->has_palette) {
-        // Load the palette from the stream
-        if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
-            return false;
-        }
-
-        needs_pixconvert = true;
-    } else {
-        if (info->bpp <= 8) {
-            // Interpolate from fg/bg
-            needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-        }
-    }
-
-    if (needs_pixconvert) {
-        // Convert the palette to native format
-        if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
-            qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
-            return false;
-        }
+        info->palette_offset = qp_stream_tell(&qgf_image->stream);
+        qp_stream_seek(&qgf_image->stream, sizeof(qgf_palette_v1_t) + (1u << info->bpp) * sizeof(qgf_palette_entry_v1_t), SEEK_CUR);
     }
 
     // Handle delta if needed
@@ -204,11 +176,46 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
+    info->data_offset = qp_stream_tell(&qgf_image->stream);
+    return true;
+}
+
+static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, const qgf_frame_info_t *info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    if (!qp_internal_bpp_capable(info->bpp)) {
+        qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
+        return false;
+    }
+
+    // Handle palette if needed
+    if (info->has_palette) {
+        // Load the palette from the stream, which skips conversion if it's the same as the previous frame's
+        qp_stream_setpos(&qgf_image->stream, info->palette_offset);
+        if (!qp_internal_load_qgf_palette(device, (qp_stream_t *)&qgf_image->stream, info->bpp)) {
+            return false;
+        }
+    } else if (info->bpp <= 8) {
+        // Ensure we aren't reusing any palette
+        qp_internal_invalidate_palette();
+
+        // Interpolate from fg/bg
+        const uint16_t palette_entries = 1u << info->bpp;
+        if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries)) {
+            // Convert the palette to native format
+            if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
+                qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
+                return false;
+            }
+        }
+    }
+
     // Stream is now at the point of being able to read pixdata
+    qp_stream_setpos(&qgf_image->stream, info->data_offset);
     return true;
 }
 
-static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, const qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
     qp_dprintf("qp_drawimage_recolor: entry\n");
     painter_driver_t *driver = (painter_driver_t *)device;
     if (!driver || !driver->validate_ok) {
@@ -222,9 +229,9 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    // Read the frame info
-    if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
+    // Set up the palette and get ready to read the pixel data
+    if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_info, fg_hsv888, bg_hsv888)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not prepare frame)\n");
         return false;
     }
 
@@ -275,7 +282,20 @@ bool qp_drawimage_recolor(painter_device_t device, uint16_t x, uint16_t y, paint
     qgf_frame_info_t frame_info = {0};
     qp_pixel_t       fg_hsv888  = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
     qp_pixel_t       bg_hsv888  = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    return qp_drawimage_recolor_impl(device, x, y, image, 0, &frame_info, fg_hsv888, bg_hsv888);
+
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok) {
+        qp_dprintf("qp_drawimage_recolor: fail (invalid image)\n");
+        return false;
+    }
+
+    // Read the frame info
+    if (!qp_drawimage_read_frame_info(qgf_image, 0, &frame_info)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not read frame 0)\n");
+        return false;
+    }
+
+    return qp_drawimage_recolor_impl(device, x, y, image, &frame_info, fg_hsv888, bg_hsv888);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -296,6 +316,7 @@ typedef struct animation_state_t {
     qp_pixel_t             fg_hsv888;
     qp_pixel_t             bg_hsv888;
     uint16_t               frame_number;
+    qgf_frame_info_t       frame_info; // Prefetched info for the frame that's drawn next
     deferred_token         defer_token;
 } animation_state_t;
 
@@ -303,15 +324,17 @@ static deferred_executor_t animation_executors[QUANTUM_PAINTER_CONCURRENT_ANIMAT
 static animation_state_t   animation_states[QUANTUM_PAINTER_CONCURRENT_ANIMATIONS]    = {0};
 
 static deferred_token qp_render_animation_state(animation_state_t *state, uint16_t *delay_ms) {
-    qgf_frame_info_t frame_info = {0};
     qp_dprintf("qp_render_animation_state: entry (frame #%d)\n", (int)state->frame_number);
-    bool ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
+    bool ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, &state->frame_info, state->fg_hsv888, state->bg_hsv888);
     if (ret) {
+        *delay_ms = state->frame_info.delay;
         ++state->frame_number;
         if (state->frame_number >= state->image->frame_count) {
             state->frame_number = 0;
         }
-        *delay_ms = frame_info.delay;
+
+        // Prefetch the next frame's info now, so that the next tick can go straight to streaming its pixel data
+        ret = qp_drawimage_read_frame_info((qgf_image_handle_t *)state->image, state->frame_number, &state->frame_info);
     }
     qp_dprintf("qp_render_animation_state: %s (delay %dms)\n", ret ? "ok" : "fail", (int)(*delay_ms));
     return ret;
@@ -354,6 +377,14 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
     anim_state->bg_hsv888    = (qp_pixel_t){.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
     anim_state->frame_number = 0;
 
+    // Read the first frame's info
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok || !qp_drawimage_read_frame_info(qgf_image, 0, &anim_state->frame_info)) {
+        anim_state->device = NULL; // disregard the allocated animation slot
+        qp_dprintf("qp_animate_recolor: fail (could not read first frame)\n");
+        return INVALID_DEFERRED_TOKEN;
+    }
+
     // Draw the first frame
     uint16_t delay_ms;
     if (!qp_render_animation_state(anim_state, &delay_ms)) {
@@ -394,3 +425,10 @@ void qp_internal_animation_tick(void) {
     static uint32_t last_anim_exec = 0;
     deferred_exec_advanced_task(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, &last_anim_exec);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: qp_internal_animation_next_trigger
+
+bool qp_internal_animation_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_next_trigger_advanced(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, trigger_time);
+}
@@ -16,6 +16,7 @@ typedef struct qff_font_handle_t {
     painter_font_desc_t   base;
     bool                  validate_ok;
     bool                  has_ascii_table;
+    bool                  unicode_sorted;
     uint16_t              num_unicode_glyphs;
     uint8_t               bpp;
     bool                  has_palette;
@@ -36,9 +37,69 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t         device;
+    const qff_font_handle_t *font;
+    uint32_t                 code_point;
+    uint32_t                 fg;
+    uint32_t                 bg;
+    uint32_t                 last_used; // zero if the entry is unused
+    uint8_t                  width;
+    uint8_t                  pixdata[QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE];
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint32_t               glyph_cache_clock                                = 0;
+
+static void qp_glyph_cache_invalidate_font(const qff_font_handle_t *font) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == font) {
+            glyph_cache[i].last_used = 0;
+        }
+    }
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+// Drops any glyphs cached for the device, as their pixel data is no longer valid
+void qp_internal_invalidate_glyph_cache(painter_device_t device) {
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].device == device) {
+            glyph_cache[i].last_used = 0;
+        }
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
+static bool qp_load_font_check_unicode_order(qff_font_handle_t *font) {
+    uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                   // Skip the font descriptor
+                                 + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
+                                 + sizeof(qgf_block_header_v1_t);                                   // Skip the unicode block header
+    if (font->num_unicode_glyphs == 0 || qp_stream_setpos(&font->stream, glyph_info_offset) < 0) {
+        return false;
+    }
+
+    qff_unicode_glyph_v1_t glyph_info;
+    uint32_t               prev_code_point = 0;
+    for (uint16_t i = 0; i < font->num_unicode_glyphs; ++i) {
+        if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &font->stream) != 1) {
+            return false;
+        }
+        if (i > 0 && glyph_info.code_point <= prev_code_point) {
+            return false;
+        }
+        prev_code_point = glyph_info.code_point;
+    }
+    return true;
+}
+
 static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_font_handle_t *font, void *arg), void *arg) {
     qp_dprintf("qp_load_font: entry\n");
     qff_font_handle_t *font = NULL;
@@ -100,6 +161,9 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     // Read the info (parsing already successful above, no need to check return value)
     qff_read_font_descriptor(&font->stream, &font->base.line_height, &font->has_ascii_table, &font->num_unicode_glyphs, &font->bpp, &font->has_palette, &font->is_panel_native, &font->compression_scheme, NULL);
 
+    // Fonts generated by the CLI have their unicode glyphs in ascending order, allowing for binary search
+    font->unicode_sorted = qp_load_font_check_unicode_order(font);
+
     if (!qp_internal_bpp_capable(font->bpp)) {
         qp_dprintf("qp_load_font: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)font->bpp);
         qp_close_font((painter_font_handle_t)font);
@@ -151,6 +215,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Drop any cached glyphs, as the slot may be reused by a different font
+    qp_glyph_cache_invalidate_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -161,7 +230,7 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -188,13 +257,12 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     if (qff_font->has_palette) {
         // If this font has a palette, we need to read it out and set up the pixel lookup table
         qp_stream_setpos(&qff_font->stream, offset);
-        if (!qp_internal_load_qgf_palette(&qff_font->stream, qff_font->bpp)) {
+        if (!qp_internal_load_qgf_palette(device, &qff_font->stream, qff_font->bpp)) {
             return false;
         }
 
         // Skip this block, as far as offset calculations go
         offset += sizeof(qgf_palette_v1_t) + (palette_entries * 3);
-        needs_pixconvert = true;
     } else {
         // Interpolate from fg/bg
         int16_t palette_entries = 1 << qff_font->bpp;
@@ -214,7 +282,9 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     return true;
 }
 
-static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+// Helper that looks up the width and data offset of the glyph for the code point
+static inline bool qp_drawtext_read_glyph_info(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width, uint32_t *data_offset) {
+    uint32_t glyph_value;
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
         qff_ascii_glyph_v1_t glyph_info;
@@ -231,68 +301,73 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
-        return true;
+        glyph_value = glyph_info.value;
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
         uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
                                      + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
                                      + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
 
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing glyph data\n");
-            return false;
-        }
+        // Binary search if the glyphs are in order, otherwise check each of them in turn
+        uint16_t lo    = 0;
+        uint16_t hi    = qff_font->num_unicode_glyphs;
+        bool     found = false;
+        while (lo < hi) {
+            // A linear search only needs to seek to the start, as the glyphs are then read in turn
+            uint16_t i = qff_font->unicode_sorted ? lo + (hi - lo) / 2 : lo;
+            if ((qff_font->unicode_sorted || i == 0) && qp_stream_setpos(&qff_font->stream, glyph_info_offset + i * sizeof(qff_unicode_glyph_v1_t)) < 0) {
+                qp_dprintf("Failed to set stream position while preparing glyph data\n");
+                return false;
+            }
 
-        qff_unicode_glyph_v1_t glyph_info;
-        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
+            qff_unicode_glyph_v1_t glyph_info;
             if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
                 qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
                 return false;
             }
 
             if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
-                return true;
+                glyph_value = glyph_info.value;
+                found       = true;
+                break;
+            } else if (!qff_font->unicode_sorted || glyph_info.code_point < code_point) {
+                lo = i + 1;
+            } else {
+                hi = i;
             }
         }
 
-        // Not found
-        qp_dprintf("Failed to find unicode glyph info\n");
+        if (!found) {
+            qp_dprintf("Failed to find unicode glyph info\n");
+            return false;
+        }
+    }
+
+    uint32_t glyph_offset = ((glyph_value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    *width                = (uint8_t)(glyph_value & QFF_GLYPH_WIDTH_MASK);
+    *data_offset          = sizeof(qff_font_descriptor_v1_t)                                                                                                                  // Skip the font descriptor
+                          + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
+                          + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                          + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
+                          + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
+                          + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
+    return true;
+}
+
+static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    uint32_t data_offset;
+    if (!qp_drawtext_read_glyph_info(qff_font, code_point, width, &data_offset)) {
+        return false;
+    }
+
+    if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
         return false;
     }
-    return false;
+    return true;
 }
 
-// Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
+// Function to iterate over each UTF8 codepoint, invoking the callback for each decoded code point
 static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
@@ -302,13 +377,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -325,9 +394,16 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+    uint8_t  width;
+    uint32_t data_offset;
+    if (!qp_drawtext_read_glyph_info(qff_font, code_point, &width, &data_offset)) {
+        qp_dprintf("Failed to read glyph info.\n");
+        return false;
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -337,6 +413,16 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // String drawing implementation
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+// Maximum number of adjacent cached glyphs sent to the display in one go -- never more than the number of cache entries,
+// so that glyphs waiting to be sent are never evicted
+#    if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES < 16
+#        define QP_GLYPH_CACHE_MAX_RUN QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+#    else
+#        define QP_GLYPH_CACHE_MAX_RUN 16
+#    endif
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
 // Callback state
 typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
@@ -345,14 +431,26 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    uint32_t                fg;
+    uint32_t                bg;
+    int16_t                 run_xpos;
+    uint8_t                 run_count;
+    qp_glyph_cache_entry_t *run[QP_GLYPH_CACHE_MAX_RUN];
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
 } code_point_iter_drawglyph_state_t;
 
-// Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
-    code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
-    painter_driver_t *                 driver = (painter_driver_t *)state->device;
+// Decodes the glyph from the font, and streams it to the display
+static inline bool qp_drawtext_draw_glyph(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, uint32_t code_point) {
+    painter_driver_t *driver = (painter_driver_t *)state->device;
+    uint8_t           width;
+    uint8_t           height = qff_font->base.line_height;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_drawtext_prepare_glyph_for_render()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
     // Reset the output state
@@ -369,6 +467,160 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        pixdata;
+    uint32_t         write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->pixdata, palette, state->write_pos++, 1, &index);
+}
+
+static bool qp_glyph_cache_byte_appender(uint8_t byteval, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state = (qp_glyph_cache_output_state_t *)cb_arg;
+    state->pixdata[state->write_pos++]   = byteval;
+    return true;
+}
+
+// Returns the cached glyph, decoding it into the least recently used entry if needed. Returns NULL if the glyph can't be
+// cached, in which case it needs to be drawn directly from the font.
+static qp_glyph_cache_entry_t *qp_glyph_cache_get(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, uint32_t code_point) {
+    painter_driver_t *      driver = (painter_driver_t *)state->device;
+    qp_glyph_cache_entry_t *entry  = &glyph_cache[0];
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *candidate = &glyph_cache[i];
+        if (candidate->last_used && candidate->code_point == code_point && candidate->font == qff_font && candidate->device == state->device && candidate->fg == state->fg && candidate->bg == state->bg) {
+            candidate->last_used = ++glyph_cache_clock;
+            return candidate;
+        }
+        if (candidate->last_used < entry->last_used) {
+            entry = candidate;
+        }
+    }
+
+    // Native fonts are copied as-is, so they need to match the display
+    if (qff_font->bpp > 8 && qff_font->bpp != driver->native_bits_per_pixel) {
+        return NULL;
+    }
+
+    uint8_t  width;
+    uint32_t data_offset;
+    if (!qp_drawtext_read_glyph_info(qff_font, code_point, &width, &data_offset)) {
+        return NULL;
+    }
+    uint32_t pixel_count = ((uint32_t)width) * qff_font->base.line_height;
+    uint32_t byte_count  = (pixel_count * driver->native_bits_per_pixel + 7) / 8;
+    if (byte_count > QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE || qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
+        return NULL;
+    }
+
+    // Decode the glyph into the entry, in the display's native format
+    state->input_state->rle.mode               = MARKER_BYTE; // ignored if not using RLE
+    entry->last_used                           = 0;
+    qp_glyph_cache_output_state_t output_state = {.device = state->device, .pixdata = entry->pixdata, .write_pos = 0};
+    bool                          ok;
+    if (qff_font->bpp <= 8) {
+        ok = qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &output_state);
+    } else {
+        ok = qp_internal_send_bytes(state->device, byte_count, state->input_callback, state->input_state, qp_glyph_cache_byte_appender, &output_state);
+    }
+    if (!ok) {
+        return NULL;
+    }
+
+    entry->device     = state->device;
+    entry->font       = qff_font;
+    entry->code_point = code_point;
+    entry->fg         = state->fg;
+    entry->bg         = state->bg;
+    entry->width      = width;
+    entry->last_used  = ++glyph_cache_clock;
+    return entry;
+}
+
+// Sends the pending run of cached glyphs to the display
+static bool qp_drawtext_flush_run(code_point_iter_drawglyph_state_t *state, uint8_t height) {
+    painter_driver_t *driver    = (painter_driver_t *)state->device;
+    uint8_t           run_count = state->run_count;
+    state->run_count            = 0;
+    if (run_count == 0) {
+        return true;
+    }
+
+    // Glyphs can only be interleaved row by row if each row of pixels starts on a byte boundary
+    uint16_t run_width   = 0;
+    uint16_t max_segment = 0;
+    for (uint8_t i = 0; i < run_count; ++i) {
+        run_width += state->run[i]->width;
+        max_segment = QP_MAX(max_segment, state->run[i]->width * driver->native_bits_per_pixel / 8);
+    }
+    bool interleave = run_count > 1 && driver->native_bits_per_pixel % 8 == 0 && max_segment <= QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE;
+
+    if (!interleave) {
+        int16_t xpos = state->run_xpos;
+        for (uint8_t i = 0; i < run_count; ++i) {
+            uint8_t width = state->run[i]->width;
+            driver->driver_vtable->viewport(state->device, xpos, state->ypos, xpos + width - 1, state->ypos + height - 1);
+            if (!driver->driver_vtable->pixdata(state->device, state->run[i]->pixdata, ((uint32_t)width) * height)) {
+                return false;
+            }
+            xpos += width;
+        }
+        return true;
+    }
+
+    // Set up a single viewport covering the whole run, and send it a row at a time
+    driver->driver_vtable->viewport(state->device, state->run_xpos, state->ypos, state->run_xpos + run_width - 1, state->ypos + height - 1);
+    uint8_t  bytes_per_pixel = driver->native_bits_per_pixel / 8;
+    uint32_t write_pos       = 0;
+    for (uint8_t y = 0; y < height; ++y) {
+        for (uint8_t i = 0; i < run_count; ++i) {
+            uint16_t segment = state->run[i]->width * bytes_per_pixel;
+            if (write_pos + segment > QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) {
+                if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, write_pos / bytes_per_pixel)) {
+                    return false;
+                }
+                write_pos = 0;
+            }
+            const uint8_t *src = &state->run[i]->pixdata[y * segment];
+            for (uint16_t n = 0; n < segment; ++n) {
+                qp_internal_global_pixdata_buffer[write_pos++] = src[n];
+            }
+        }
+    }
+    return driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, write_pos / bytes_per_pixel);
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+// Codepoint handler callback: drawing
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
+    code_point_iter_drawglyph_state_t *state = (code_point_iter_drawglyph_state_t *)cb_arg;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_get(state, qff_font, code_point);
+    if (entry) {
+        // Queue up the glyph, so that adjacent glyphs can be sent together
+        if (state->run_count == 0) {
+            state->run_xpos = state->xpos;
+        }
+        state->run[state->run_count++] = entry;
+        state->xpos += entry->width;
+        return state->run_count < QP_GLYPH_CACHE_MAX_RUN || qp_drawtext_flush_run(state, qff_font->base.line_height);
+    }
+
+    // Glyphs need to be drawn in order, so send anything pending first
+    if (!qp_drawtext_flush_run(state, qff_font->base.line_height)) {
+        return false;
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+    return qp_drawtext_draw_glyph(state, qff_font, code_point);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_textwidth
 
@@ -448,8 +700,17 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Palette-based fonts look the same regardless of the requested colors
+    state.fg = qff_font->has_palette ? 0 : ((uint32_t)hue_fg << 16 | (uint32_t)sat_fg << 8 | val_fg);
+    state.bg = qff_font->has_palette ? 0 : ((uint32_t)hue_bg << 16 | (uint32_t)sat_bg << 8 | val_bg);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    ret = qp_drawtext_flush_run(&state, qff_font->base.line_height) && ret;
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
 
     qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
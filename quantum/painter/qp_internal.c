@@ -20,7 +20,7 @@ enum {
                      + (SH1106_NUM_DEVICES)  // SH1106
 };
 
-static painter_device_t qp_devices[QP_NUM_DEVICES] = {NULL};
+static painter_device_t qp_devices[QP_NUM_DEVICES];
 
 bool qp_internal_register_device(painter_device_t driver) {
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
@@ -103,3 +103,27 @@ void qp_internal_task(void) {
     debug_enable = old_debug_state;
 #endif // defined(QUANTUM_PAINTER_DEBUG_ENABLE_FLUSH_TASK_OUTPUT)
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: qp_internal_next_deadline
+
+bool qp_internal_next_deadline(uint32_t *deadline) {
+    bool     pending = false;
+    uint32_t trigger_time;
+
+    bool qp_internal_animation_next_trigger(uint32_t *trigger_time);
+    if (qp_internal_animation_next_trigger(&trigger_time)) {
+        *deadline = trigger_time;
+        pending   = true;
+    }
+
+#ifdef QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
+    bool qp_lvgl_internal_next_trigger(uint32_t *trigger_time);
+    if (qp_lvgl_internal_next_trigger(&trigger_time) && (!pending || (int32_t)TIMER_DIFF_32(trigger_time, *deadline) < 0)) {
+        *deadline = trigger_time;
+        pending   = true;
+    }
+#endif
+
+    return pending;
+}
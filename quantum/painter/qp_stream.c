@@ -6,9 +6,24 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
+static inline int16_t mem_get(qp_stream_t *stream);
+
 uint32_t qp_stream_read_impl(void *output_buf, uint32_t member_size, uint32_t num_members, qp_stream_t *stream) {
     uint8_t *output_ptr = (uint8_t *)output_buf;
 
+    // Memory streams can copy the whole lot in one go
+    if (stream->get == mem_get) {
+        qp_memory_stream_t *s         = (qp_memory_stream_t *)stream;
+        uint32_t            available = s->position < s->length ? s->length - s->position : 0;
+        uint32_t            count     = QP_MIN(num_members * member_size, available);
+        memcpy(output_ptr, &s->buffer[s->position], count);
+        s->position += count;
+        if (count < num_members * member_size) {
+            s->is_eof = true;
+        }
+        return count / member_size;
+    }
+
     uint32_t i;
     for (i = 0; i < (num_members * member_size); ++i) {
         int16_t c = qp_stream_get(stream);
@@ -185,6 +185,7 @@ ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_SURFACE)), yes)
     SRC += \
         $(DRIVER_PATH)/painter/generic/qp_surface_common.c \
         $(DRIVER_PATH)/painter/generic/qp_surface_mono1bpp.c \
+        $(DRIVER_PATH)/painter/generic/qp_surface_palette.c \
         $(DRIVER_PATH)/painter/generic/qp_surface_rgb565.c
 endif
 
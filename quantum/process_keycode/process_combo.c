@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -75,6 +76,7 @@ __attribute__((weak)) bool combo_should_trigger(uint16_t combo_index, combo_t *c
 static uint16_t timer = 0;
 #endif
 static bool     b_combo_enable = true; // defaults to enabled
+static bool     b_combo_dirty  = false; // set once any combo state may need to be cleared
 static uint16_t longest_term   = 0;
 
 typedef struct {
@@ -194,10 +196,17 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+    if (!b_combo_dirty) {
+        return;
+    }
+    b_combo_dirty = false;
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
             RESET_COMBO_STATE(combo);
+        } else {
+            // still needs to be cleared once released
+            b_combo_dirty = true;
         }
     }
 }
@@ -256,7 +265,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -414,6 +422,77 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
+#ifdef COMBO_INDEX_SIZE
+/* Inverted index of the combos, so that each key event only visits the combos that may contain its keycode.
+ * Keycodes are hashed into buckets, and the combos containing any keycode of bucket b are stored in ascending
+ * order in combo_index_entries[combo_index_start[b]] to combo_index_entries[combo_index_start[b + 1] - 1].
+ * Hash collisions are harmless, as process_single_combo() ignores combos that don't contain the keycode. */
+#    define COMBO_INDEX_BUCKETS 32
+#    define COMBO_INDEX_BUCKET(keycode) (((keycode) ^ ((keycode) >> 5) ^ ((keycode) >> 10)) & (COMBO_INDEX_BUCKETS - 1))
+
+static uint16_t combo_index_start[COMBO_INDEX_BUCKETS + 1];
+static uint16_t combo_index_entries[COMBO_INDEX_SIZE];
+static uint16_t combo_index_count = 0;
+static bool     combo_index_built = false;
+static bool     combo_index_fits  = false;
+
+static uint32_t combo_index_buckets_of(combo_t *combo) {
+    uint32_t buckets = 0;
+    uint16_t key;
+    for (uint8_t i = 0; (key = pgm_read_word(&combo->keys[i])) != COMBO_END; ++i) {
+        buckets |= (uint32_t)1 << COMBO_INDEX_BUCKET(key);
+    }
+    return buckets;
+}
+
+static void combo_index_build(void) {
+    combo_index_count = combo_count();
+    combo_index_built = true;
+    combo_index_fits  = false;
+
+    /* Count the combos in each bucket, then turn the counts into the end of each bucket */
+    memset(combo_index_start, 0, sizeof(combo_index_start));
+    for (uint16_t idx = 0; idx < combo_index_count; ++idx) {
+        uint32_t buckets = combo_index_buckets_of(combo_get(idx));
+        for (uint8_t bucket = 0; bucket < COMBO_INDEX_BUCKETS; ++bucket) {
+            if (buckets & ((uint32_t)1 << bucket)) {
+                combo_index_start[bucket]++;
+            }
+        }
+    }
+    for (uint8_t bucket = 1; bucket < COMBO_INDEX_BUCKETS; ++bucket) {
+        combo_index_start[bucket] += combo_index_start[bucket - 1];
+    }
+    combo_index_start[COMBO_INDEX_BUCKETS] = combo_index_start[COMBO_INDEX_BUCKETS - 1];
+    if (combo_index_start[COMBO_INDEX_BUCKETS] > COMBO_INDEX_SIZE) {
+        /* Too many combos for the index, fall back to visiting all of them */
+        return;
+    }
+
+    /* Fill the buckets back to front, leaving each start pointing at the beginning of its bucket */
+    for (uint16_t idx = combo_index_count; idx-- > 0;) {
+        uint32_t buckets = combo_index_buckets_of(combo_get(idx));
+        for (uint8_t bucket = 0; bucket < COMBO_INDEX_BUCKETS; ++bucket) {
+            if (buckets & ((uint32_t)1 << bucket)) {
+                combo_index_entries[--combo_index_start[bucket]] = idx;
+            }
+        }
+    }
+    combo_index_fits = true;
+}
+
+static inline bool combo_index_ready(void) {
+    if (!combo_index_built || combo_index_count != combo_count()) {
+        combo_index_build();
+    }
+    return combo_index_fits;
+}
+
+void combo_index_invalidate(void) {
+    combo_index_built = false;
+}
+#endif
+
 static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
     uint8_t  key_count = 0;
     uint16_t key_index = -1;
@@ -423,6 +502,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     if (-1 == (int16_t)key_index) {
         return false;
     }
+    b_combo_dirty = true;
 
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
@@ -535,8 +615,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +643,20 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_SIZE
+    if (combo_index_ready()) {
+        /* Only visit the combos that may contain this keycode, in the same order as below. */
+        uint8_t bucket = COMBO_INDEX_BUCKET(keycode);
+        for (uint16_t i = combo_index_start[bucket]; i < combo_index_start[bucket + 1]; ++i) {
+            uint16_t idx = combo_index_entries[i];
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -625,6 +714,19 @@ void combo_task(void) {
 #endif
 }
 
+bool combo_next_deadline(uint32_t *deadline) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        // combo_task() acts once the elapsed time exceeds the longest term
+        uint32_t now     = timer_read32();
+        uint16_t elapsed = TIMER_DIFF_16((uint16_t)now, timer);
+        *deadline        = now + (elapsed <= longest_term ? longest_term - elapsed + 1 : 0);
+        return true;
+    }
+#endif
+    return false;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
@@ -81,3 +81,11 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+/* Next point in time at which combo_task() needs to run, false if none is pending */
+bool combo_next_deadline(uint32_t *deadline);
+
+#ifdef COMBO_INDEX_SIZE
+/* Must be called after changing the keys of any combo at runtime */
+void combo_index_invalidate(void);
+#endif
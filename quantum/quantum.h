@@ -240,6 +240,22 @@ extern layer_state_t layer_state;
 #    include "os_detection.h"
 #endif
 
+#ifdef TASK_PROFILER_ENABLE
+#    include "task_profiler.h"
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+#    include "split_telemetry.h"
+#endif
+
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 void set_single_persistent_default_layer(uint8_t default_layer);
 
 #define IS_LAYER_ON(layer) layer_state_is(layer)
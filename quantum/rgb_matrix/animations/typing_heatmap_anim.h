@@ -16,32 +16,116 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// Heat that a key press at `pressed` spreads to the key at `target`, zero if it is out of reach
+static uint8_t typing_heatmap_spread_amount(led_point_t pressed, led_point_t target) {
+    int16_t dx = target.x - pressed.x;
+    int16_t dy = target.y - pressed.y;
+    // Cheap rejection of keys well outside the spread before calculating the distance
+    if (dx < -RGB_MATRIX_TYPING_HEATMAP_SPREAD || dx > RGB_MATRIX_TYPING_HEATMAP_SPREAD || dy < -RGB_MATRIX_TYPING_HEATMAP_SPREAD || dy > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t distance = sqrt16(dx * dx + dy * dy);
+    if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+    }
+    return amount;
+}
+
+#            ifdef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE
+#                ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE_SIZE
+#                    define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE_SIZE (RGB_MATRIX_LED_COUNT * 8)
+#                endif
+#                define HEATMAP_NEIGHBORS_UNCACHED UINT16_MAX
+
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    uint8_t amount;
+} heatmap_neighbor_t;
+
+// Keys within reach of each key, stored back to back, as the LED positions never change
+static heatmap_neighbor_t heatmap_neighbors[RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE_SIZE];
+// Range of the neighbors of each key, start is HEATMAP_NEIGHBORS_UNCACHED if they did not fit
+static uint16_t heatmap_neighbors_start[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t heatmap_neighbors_end[MATRIX_ROWS][MATRIX_COLS];
+static bool     heatmap_neighbors_ready = false;
+
+static void typing_heatmap_build_neighbors(void) {
+    uint16_t count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led == NO_LED) {
+                continue;
+            }
+            uint16_t start = count;
+            for (uint8_t i_row = 0; i_row < MATRIX_ROWS && start != HEATMAP_NEIGHBORS_UNCACHED; i_row++) {
+                for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                    uint8_t target = g_led_config.matrix_co[i_row][i_col];
+                    if (target == NO_LED || (i_row == row && i_col == col)) {
+                        continue;
+                    }
+                    uint8_t amount = typing_heatmap_spread_amount(g_led_config.point[led], g_led_config.point[target]);
+                    if (amount == 0) {
+                        continue;
+                    }
+                    if (count == RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE_SIZE) {
+                        // Out of space, this key falls back to scanning the whole matrix
+                        count = start;
+                        start = HEATMAP_NEIGHBORS_UNCACHED;
+                        break;
+                    }
+                    heatmap_neighbors[count++] = (heatmap_neighbor_t){.row = i_row, .col = i_col, .amount = amount};
+                }
+            }
+            heatmap_neighbors_start[row][col] = start;
+            heatmap_neighbors_end[row][col]   = count;
+        }
+    }
+    heatmap_neighbors_ready = true;
+}
+#            endif
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
     g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
 #        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
+        return;
+    }
+    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+
+#            ifdef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE
+    if (!heatmap_neighbors_ready) {
+        typing_heatmap_build_neighbors();
+    }
+    if (heatmap_neighbors_start[row][col] != HEATMAP_NEIGHBORS_UNCACHED) {
+        for (uint16_t i = heatmap_neighbors_start[row][col]; i < heatmap_neighbors_end[row][col]; i++) {
+            heatmap_neighbor_t n             = heatmap_neighbors[i];
+            g_rgb_frame_buffer[n.row][n.col] = qadd8(g_rgb_frame_buffer[n.row][n.col], n.amount);
+        }
         return;
     }
+#            endif
+
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+            uint8_t target = g_led_config.matrix_co[i_row][i_col];
+            if (target == NO_LED || (i_row == row && i_col == col)) { // skip as target key doesn't have an led position, or is the pressed key
                 continue;
             }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t amount = typing_heatmap_spread_amount(g_led_config.point[led], g_led_config.point[target]);
+            if (amount) {
+                g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
             }
         }
     }
@@ -59,6 +143,11 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && defined(RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE)
+        if (!heatmap_neighbors_ready) {
+            typing_heatmap_build_neighbors();
+        }
+#        endif
     }
 
     // The heatmap animation might run in several iterations depending on
@@ -29,6 +29,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_FRAME_PACING
+#    include "task_profiler.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -69,6 +73,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_POLAR_CACHE
+led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_POLAR_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -88,6 +95,21 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+// frame pacing
+#ifdef RGB_MATRIX_FRAME_PACING
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+static uint8_t rgb_render_batch = RGB_MATRIX_LED_PROCESS_LIMIT;
+#    else
+static uint8_t rgb_render_batch = RGB_MATRIX_LED_COUNT;
+#    endif
+static struct rgb_matrix_limits_t rgb_render_limits;
+static uint32_t                   rgb_render_budget;
+static uint32_t                   rgb_frame_due;
+static rgb_matrix_frame_stats_t   rgb_frame_stats;
+static uint16_t                   rgb_fps_frames;
+static uint32_t                   rgb_fps_timer;
+#endif // RGB_MATRIX_FRAME_PACING
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
 
 void eeconfig_update_rgb_matrix(void) {
@@ -261,12 +283,38 @@ static void rgb_task_timers(void) {
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
+#ifdef RGB_MATRIX_FRAME_PACING
+    if (timer_expired32(sync_timer_read32(), rgb_frame_due)) rgb_task_state = STARTING;
+#else
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif // RGB_MATRIX_FRAME_PACING
+}
+
+#ifdef RGB_MATRIX_FRAME_PACING
+// Schedules the frame after the one being started, keeping a fixed interval between frames
+static void rgb_task_pace(void) {
+    uint32_t now = sync_timer_read32();
+    if (timer_expired32(now, rgb_frame_due)) {
+        uint32_t missed = TIMER_DIFF_32(now, rgb_frame_due) / RGB_MATRIX_LED_FLUSH_LIMIT;
+        if (missed) {
+            // too late to catch up, restart the schedule from now
+            rgb_frame_stats.dropped += missed;
+            rgb_frame_due = now;
+        }
+        rgb_frame_due += RGB_MATRIX_LED_FLUSH_LIMIT;
+    } else {
+        // started ahead of schedule, e.g. by a mode change
+        rgb_frame_due = now + RGB_MATRIX_LED_FLUSH_LIMIT;
+    }
 }
+#endif // RGB_MATRIX_FRAME_PACING
 
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_task_pace();
+#endif // RGB_MATRIX_FRAME_PACING
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -278,6 +326,36 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_FRAME_PACING
+// Picks the LEDs for the next render call, continuing where the previous one stopped
+static void rgb_task_render_limits(void) {
+    uint16_t min = rgb_effect_params.iter == 0 ? 0 : rgb_render_limits.led_max_index;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (!is_keyboard_left() && min < k_rgb_matrix_split[0]) min = k_rgb_matrix_split[0];
+#    endif
+    uint16_t max = min + rgb_render_batch;
+    if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left() && max > k_rgb_matrix_split[0]) max = k_rgb_matrix_split[0];
+#    endif
+    rgb_render_limits.led_min_index = min;
+    rgb_render_limits.led_max_index = max;
+}
+
+// Resizes the batch from the cost of the previous render call, so that the next ones fit in the budget
+static void rgb_task_render_adapt(uint32_t cost) {
+    uint8_t count = rgb_render_limits.led_max_index - rgb_render_limits.led_min_index;
+    if (count == 0) return;
+
+    uint32_t batch = cost ? count * rgb_render_budget / cost : RGB_MATRIX_LED_COUNT;
+    // grow gradually, a single cheap call doesn't say much about the next ones
+    if (batch > 2 * rgb_render_batch) batch = 2 * rgb_render_batch;
+    if (batch < 1) batch = 1;
+    if (batch > RGB_MATRIX_LED_COUNT) batch = RGB_MATRIX_LED_COUNT;
+    rgb_render_batch = batch;
+}
+#endif // RGB_MATRIX_FRAME_PACING
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
@@ -285,6 +363,9 @@ static void rgb_task_render(uint8_t effect) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_task_render_limits();
+#endif // RGB_MATRIX_FRAME_PACING
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
@@ -346,6 +427,17 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_frame_stats.frames++;
+    rgb_fps_frames++;
+    uint32_t fps_time = timer_elapsed32(rgb_fps_timer);
+    if (fps_time >= 1000) {
+        rgb_frame_stats.fps = (uint32_t)rgb_fps_frames * 1000 / fps_time;
+        rgb_fps_frames      = 0;
+        rgb_fps_timer       = timer_read32();
+    }
+#endif // RGB_MATRIX_FRAME_PACING
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -367,7 +459,10 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_FRAME_PACING
+            uint32_t render_start = task_profiler_ticks();
+#endif // RGB_MATRIX_FRAME_PACING
             rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
@@ -375,7 +470,11 @@ void rgb_matrix_task(void) {
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
+#ifdef RGB_MATRIX_FRAME_PACING
+            rgb_task_render_adapt(task_profiler_ticks() - render_start);
+#endif // RGB_MATRIX_FRAME_PACING
             break;
+        }
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -385,6 +484,25 @@ void rgb_matrix_task(void) {
     }
 }
 
+bool rgb_matrix_next_deadline(uint32_t *deadline) {
+    uint32_t now = timer_read32();
+
+    // Renders are spread over several passes, so only the wait between frames can be slept through
+    if (rgb_task_state != SYNCING) {
+        *deadline = now;
+        return true;
+    }
+
+#ifdef RGB_MATRIX_FRAME_PACING
+    uint32_t sync_now = sync_timer_read32();
+    *deadline         = now + (timer_expired32(sync_now, rgb_frame_due) ? 0 : rgb_frame_due - sync_now);
+#else
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    *deadline        = now + (elapsed < RGB_MATRIX_LED_FLUSH_LIMIT ? RGB_MATRIX_LED_FLUSH_LIMIT - elapsed : 0);
+#endif // RGB_MATRIX_FRAME_PACING
+    return true;
+}
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
 }
@@ -398,6 +516,10 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 }
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
+#ifdef RGB_MATRIX_FRAME_PACING
+    // batches are sized at runtime, so only the one being rendered is known
+    return rgb_render_limits;
+#endif // RGB_MATRIX_FRAME_PACING
     struct rgb_matrix_limits_t limits = {0};
 #if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
@@ -448,6 +570,22 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_render_budget = (uint32_t)RGB_MATRIX_RENDER_BUDGET_US * task_profiler_ticks_per_ms() / 1000;
+    rgb_fps_timer     = timer_read32();
+    rgb_frame_due     = sync_timer_read32();
+#endif // RGB_MATRIX_FRAME_PACING
+
+#ifdef RGB_MATRIX_POLAR_CACHE
+    // LED positions never change, so the per-frame sqrt16() and atan2_8() calls are done once up front
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif // RGB_MATRIX_POLAR_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -476,12 +614,23 @@ void rgb_matrix_set_suspend_state(bool state) {
     }
     suspend_state = state;
 #endif
+#ifdef RGB_MATRIX_FRAME_PACING
+    // frames aren't missed while the keyboard is asleep
+    if (!state) rgb_frame_due = sync_timer_read32();
+#endif // RGB_MATRIX_FRAME_PACING
 }
 
 bool rgb_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+#ifdef RGB_MATRIX_FRAME_PACING
+void rgb_matrix_get_frame_stats(rgb_matrix_frame_stats_t *stats) {
+    *stats            = rgb_frame_stats;
+    stats->batch_size = rgb_render_batch;
+}
+#endif // RGB_MATRIX_FRAME_PACING
+
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
     rgb_task_state = STARTING;
@@ -83,7 +83,11 @@
 #endif
 
 #ifndef RGB_MATRIX_LED_FLUSH_LIMIT
-#    define RGB_MATRIX_LED_FLUSH_LIMIT 16
+#    ifdef RGB_MATRIX_TARGET_FPS
+#        define RGB_MATRIX_LED_FLUSH_LIMIT (1000 / RGB_MATRIX_TARGET_FPS)
+#    else
+#        define RGB_MATRIX_LED_FLUSH_LIMIT 16
+#    endif
 #endif
 
 #ifndef RGB_MATRIX_LED_PROCESS_LIMIT
@@ -97,6 +101,21 @@ struct rgb_matrix_limits_t {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 
+#ifdef RGB_MATRIX_FRAME_PACING
+#    ifndef RGB_MATRIX_RENDER_BUDGET_US
+#        define RGB_MATRIX_RENDER_BUDGET_US 500
+#    endif
+
+typedef struct rgb_matrix_frame_stats_t {
+    uint16_t fps;        // frames flushed during the last full second
+    uint32_t frames;     // frames flushed since startup
+    uint32_t dropped;    // frame intervals that passed without a new frame being started
+    uint8_t  batch_size; // number of LEDs currently rendered per call of rgb_matrix_task()
+} rgb_matrix_frame_stats_t;
+
+void rgb_matrix_get_frame_stats(rgb_matrix_frame_stats_t *stats);
+#endif // RGB_MATRIX_FRAME_PACING
+
 #define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                   \
     struct rgb_matrix_limits_t limits = rgb_matrix_get_limits(iter); \
     uint8_t                    min    = limits.led_min_index;        \
@@ -152,6 +171,9 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
 
+// Next point in time at which rgb_matrix_task() has work to do
+bool rgb_matrix_next_deadline(uint32_t *deadline);
+
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
@@ -277,3 +299,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_POLAR_CACHE
+extern led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif
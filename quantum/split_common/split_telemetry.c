@@ -0,0 +1,251 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_telemetry.h"
+#include "transactions.h"
+#include "transport.h"
+#include "split_util.h"
+#include "keyboard.h"
+#include "task_profiler.h"
+#include "debug.h"
+#include "print.h"
+
+typedef struct split_telemetry_accumulator_t {
+    uint32_t attempts;
+    uint32_t retries;
+    uint32_t failures;
+    uint32_t bytes;
+    uint32_t sum_ticks;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint16_t count; // durations in sum_ticks
+    bool     last_failed;
+} split_telemetry_accumulator_t;
+
+static split_telemetry_accumulator_t accumulators[NUM_TOTAL_TRANSACTIONS];
+static split_telemetry_counters_t    counters;
+static bool                          stress_enabled = false;
+static uint8_t                       stress_lfsr    = 0xA5;
+// The request stays in the slave's shared memory, so a reset is only honoured when this changes
+static uint8_t reset_sequence = 0;
+
+// Durations are recorded in ticks, as the slave may record them from interrupt context, and only converted when read
+static uint32_t ticks_to_us(uint32_t ticks) {
+    uint32_t ticks_per_ms = task_profiler_ticks_per_ms();
+    return ticks / ticks_per_ms * 1000 + ticks % ticks_per_ms * 1000 / ticks_per_ms;
+}
+
+static bool is_local(split_telemetry_half_t half) {
+    return is_keyboard_master() == (half == SPLIT_TELEMETRY_MASTER);
+}
+
+static void reset_local(void) {
+    memset(accumulators, 0, sizeof(accumulators));
+    memset(&counters, 0, sizeof(counters));
+}
+
+static bool get_local_stats(uint8_t id, split_telemetry_stats_t *stats) {
+    if (id >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    const split_telemetry_accumulator_t *acc = &accumulators[id];
+    stats->attempts                          = acc->attempts;
+    stats->retries                           = acc->retries;
+    stats->failures                          = acc->failures;
+    stats->bytes                             = acc->bytes;
+    stats->min_us                            = ticks_to_us(acc->min_ticks);
+    stats->avg_us                            = acc->count ? ticks_to_us(acc->sum_ticks / acc->count) : 0;
+    stats->max_us                            = ticks_to_us(acc->max_ticks);
+    return true;
+}
+
+static bool fetch_remote_report(uint8_t id, split_telemetry_report_t *report) {
+    if (!is_keyboard_master() || !is_transport_connected()) {
+        return false;
+    }
+    split_telemetry_request_t request = {.id = id, .reset = reset_sequence};
+    // Some drivers run the slave callback before the request arrives, in which case the report answers the previous one
+    for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+        if (!transport_execute_transaction(EXCHANGE_TELEMETRY, &request, sizeof(request), report, sizeof(*report))) {
+            return false;
+        }
+        if (report->request.id == request.id && report->request.reset == request.reset) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t split_telemetry_start(void) {
+    return task_profiler_ticks();
+}
+
+void split_telemetry_record(int8_t id, bool success, uint32_t start) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        ++counters.invalid;
+        return;
+    }
+
+    uint32_t                       ticks = task_profiler_ticks() - start;
+    split_telemetry_accumulator_t *acc   = &accumulators[id];
+    ++acc->attempts;
+    // Only the master retries, the slave just sees another transaction
+    if (acc->last_failed && is_keyboard_master()) {
+        ++acc->retries;
+    }
+    acc->last_failed = !success;
+    if (!success) {
+        ++acc->failures;
+        return;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    acc->bytes += split_trans_initiator2target_length(trans) + trans->target2initiator_buffer_size;
+
+    // Only successful attempts count towards the durations, failed ones mostly measure the timeout
+    if (acc->count == 0 || ticks < acc->min_ticks) {
+        acc->min_ticks = ticks;
+    }
+    if (acc->count == 0 || ticks > acc->max_ticks) {
+        acc->max_ticks = ticks;
+    }
+    // Keep the running average meaningful instead of overflowing
+    if (acc->count == UINT16_MAX || acc->sum_ticks > UINT32_MAX - ticks) {
+        acc->sum_ticks /= 2;
+        acc->count /= 2;
+    }
+    acc->sum_ticks += ticks;
+    ++acc->count;
+}
+
+void split_telemetry_record_invalid(void) {
+    ++counters.invalid;
+}
+
+void split_telemetry_task(void) {
+    if (!stress_enabled || !is_transport_connected()) {
+        return;
+    }
+
+    static uint8_t previous[SPLIT_TELEMETRY_STRESS_SIZE] = {0};
+    uint8_t        request[SPLIT_TELEMETRY_STRESS_SIZE];
+    uint8_t        response[SPLIT_TELEMETRY_STRESS_SIZE];
+    for (uint8_t n = 0; n < SPLIT_TELEMETRY_STRESS_COUNT; ++n) {
+        // Galois LFSR, so that every bit of every byte keeps changing
+        for (uint8_t i = 0; i < sizeof(request); ++i) {
+            stress_lfsr = (stress_lfsr >> 1) ^ (-(stress_lfsr & 1) & 0xB8);
+            request[i]  = stress_lfsr;
+        }
+        if (!transport_execute_transaction(EXCHANGE_STRESS, request, sizeof(request), response, sizeof(response))) {
+            continue;
+        }
+
+        // Drivers that run the slave callback before the request arrives answer the previous request instead
+        bool current_ok = true, previous_ok = true;
+        for (uint8_t i = 0; i < sizeof(response); ++i) {
+            current_ok &= response[i] == (uint8_t)~request[i];
+            previous_ok &= response[i] == (uint8_t)~previous[i];
+        }
+        if (!current_ok && !previous_ok) {
+            ++counters.corrupted;
+        }
+        memcpy(previous, request, sizeof(previous));
+    }
+}
+
+void split_telemetry_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_telemetry_request_t *request = (const split_telemetry_request_t *)initiator2target_buffer;
+    split_telemetry_report_t *       report  = (split_telemetry_report_t *)target2initiator_buffer;
+
+    // After the slave restarts, this clears the statistics it has just started collecting once more, which is harmless
+    if (request->reset != reset_sequence) {
+        reset_sequence = request->reset;
+        reset_local();
+    }
+
+    memset(report, 0, sizeof(*report));
+    report->request = *request;
+    get_local_stats(request->id, &report->stats);
+    report->counters = counters;
+}
+
+void split_telemetry_slave_stress_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *request  = (const uint8_t *)initiator2target_buffer;
+    uint8_t *      response = (uint8_t *)target2initiator_buffer;
+    for (uint8_t i = 0; i < SPLIT_TELEMETRY_STRESS_SIZE; ++i) {
+        response[i] = ~request[i];
+    }
+}
+
+bool split_telemetry_get_stats(split_telemetry_half_t half, uint8_t id, split_telemetry_stats_t *stats) {
+    if (id >= NUM_TOTAL_TRANSACTIONS || stats == NULL) {
+        return false;
+    }
+    if (is_local(half)) {
+        return get_local_stats(id, stats);
+    }
+
+    split_telemetry_report_t report;
+    if (!fetch_remote_report(id, &report)) {
+        return false;
+    }
+    *stats = report.stats;
+    return true;
+}
+
+bool split_telemetry_get_counters(split_telemetry_half_t half, split_telemetry_counters_t *counters_out) {
+    if (counters_out == NULL) {
+        return false;
+    }
+    if (is_local(half)) {
+        *counters_out = counters;
+        return true;
+    }
+
+    split_telemetry_report_t report;
+    if (!fetch_remote_report(0, &report)) {
+        return false;
+    }
+    *counters_out = report.counters;
+    return true;
+}
+
+void split_telemetry_reset(void) {
+    // Should the slave be unreachable, it picks the reset up with the next request instead
+    ++reset_sequence;
+    split_telemetry_report_t report;
+    fetch_remote_report(0, &report);
+    // Cleared last, so that the reset request itself isn't counted
+    reset_local();
+}
+
+void split_telemetry_stress(bool enable) {
+    stress_enabled = enable;
+}
+
+bool split_telemetry_stress_enabled(void) {
+    return stress_enabled;
+}
+
+void split_telemetry_print(void) {
+    for (split_telemetry_half_t half = SPLIT_TELEMETRY_MASTER; half <= SPLIT_TELEMETRY_SLAVE; ++half) {
+        const char *name = half == SPLIT_TELEMETRY_MASTER ? "master" : "slave";
+        for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+            split_telemetry_stats_t stats;
+            if (!split_telemetry_get_stats(half, id, &stats)) {
+                break;
+            }
+            if (stats.attempts == 0) {
+                continue;
+            }
+            dprintf("split %s %u -- n:%lu retries:%lu failures:%lu bytes:%lu min:%luus avg:%luus max:%luus\n", name, id, stats.attempts, stats.retries, stats.failures, stats.bytes, stats.min_us, stats.avg_us, stats.max_us);
+        }
+
+        split_telemetry_counters_t half_counters;
+        if (split_telemetry_get_counters(half, &half_counters)) {
+            dprintf("split %s corrupted: %lu invalid: %lu\n", name, half_counters.corrupted, half_counters.invalid);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Split telemetry -- keeps statistics about the health and throughput of the split link.
+
+    For every transaction ID, both halves count the transactions they took part in, how many of
+    them failed, and how long they took. The master additionally counts retries, i.e. attempts
+    that directly followed a failed attempt of the same transaction. The slave's statistics are
+    retrieved by the master on request, with a dedicated transaction.
+
+    The stress mode makes the master run SPLIT_TELEMETRY_STRESS_COUNT additional transactions
+    every scan, each exchanging SPLIT_TELEMETRY_STRESS_SIZE bytes of changing data in both
+    directions. As the slave answers with the inverted data, corruption that slipped past the
+    transport is counted as well.
+*/
+
+#ifndef SPLIT_TELEMETRY_STRESS_SIZE
+#    define SPLIT_TELEMETRY_STRESS_SIZE 32
+#endif
+
+#ifndef SPLIT_TELEMETRY_STRESS_COUNT
+#    define SPLIT_TELEMETRY_STRESS_COUNT 8
+#endif
+
+typedef enum split_telemetry_half_t {
+    SPLIT_TELEMETRY_MASTER,
+    SPLIT_TELEMETRY_SLAVE,
+} split_telemetry_half_t;
+
+typedef struct split_telemetry_stats_t {
+    uint32_t attempts;
+    uint32_t retries;  // attempts following a failed one, only counted by the master
+    uint32_t failures;
+    uint32_t bytes;    // payload of the successful attempts, in both directions
+    uint32_t min_us;   // all-time minimum duration since the last reset
+    uint32_t avg_us;   // running average duration since the last reset
+    uint32_t max_us;   // all-time maximum duration since the last reset
+} split_telemetry_stats_t;
+
+typedef struct split_telemetry_counters_t {
+    uint32_t corrupted; // stress transactions that succeeded, but with the wrong data
+    uint32_t invalid;   // transactions rejected before their ID was known
+} split_telemetry_counters_t;
+
+/**
+ * Hooks invoked by the split transport. Should not be invoked by keyboard/user code.
+ */
+uint32_t split_telemetry_start(void);
+void     split_telemetry_record(int8_t id, bool success, uint32_t start);
+void     split_telemetry_record_invalid(void);
+void     split_telemetry_task(void);
+void     split_telemetry_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+void     split_telemetry_slave_stress_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+
+/**
+ * Retrieves the statistics of the given transaction, on either half. The slave's statistics are
+ * only available on the master, while the slave is connected.
+ *
+ * @return false if the transaction ID is invalid, or the slave could not be reached
+ */
+bool split_telemetry_get_stats(split_telemetry_half_t half, uint8_t id, split_telemetry_stats_t *stats);
+
+/**
+ * Retrieves the counters that aren't tied to a transaction, on either half.
+ *
+ * @return false if the slave could not be reached
+ */
+bool split_telemetry_get_counters(split_telemetry_half_t half, split_telemetry_counters_t *counters);
+
+/**
+ * Clears all statistics of both halves.
+ */
+void split_telemetry_reset(void);
+
+/**
+ * Starts or stops the stress mode.
+ */
+void split_telemetry_stress(bool enable);
+bool split_telemetry_stress_enabled(void);
+
+/**
+ * Dumps the statistics of both halves to the console.
+ */
+void split_telemetry_print(void);
@@ -13,6 +13,13 @@ void split_post_init(void);
 bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 bool is_transport_connected(void);
 
+#ifdef SPLIT_MATRIX_EVENTS
+/**
+ * Time of the latest change of the given key, which for keys on the slave half is when the slave saw it change.
+ */
+uint16_t split_matrix_event_time(uint8_t row, uint8_t col);
+#endif // SPLIT_MATRIX_EVENTS
+
 void split_watchdog_update(bool done);
 void split_watchdog_task(void);
 bool split_watchdog_check(void);
\ No newline at end of file
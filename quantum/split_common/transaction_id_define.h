@@ -24,6 +24,11 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_MATRIX_EVENTS
+    GET_SLAVE_MATRIX_EVENTS_HEAD,
+    GET_SLAVE_MATRIX_EVENTS,
+#endif // SPLIT_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -97,6 +102,19 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#if defined(SPLIT_TELEMETRY_ENABLE)
+    EXCHANGE_TELEMETRY,
+    EXCHANGE_STRESS,
+#endif // defined(SPLIT_TELEMETRY_ENABLE)
+
+#if defined(SPLIT_TRANSACTION_BATCHING)
+    EXCHANGE_BATCH,
+#endif // defined(SPLIT_TRANSACTION_BATCHING)
+
+#if defined(SPLIT_RPC_STREAMING)
+    EXCHANGE_RPC_STREAM,
+#endif // defined(SPLIT_RPC_STREAMING)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
@@ -64,6 +64,9 @@
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef SPLIT_RPC_STREAMING
+#    include "atomic_util.h"
+#endif
 
 #define SYNC_TIMER_OFFSET 2
 
@@ -84,9 +87,48 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#if defined(SPLIT_TRANSACTION_BATCHING)
+
+// Set while the master handlers run, so that writes are queued up for the batch frame and reads are served from its reply
+static bool     batch_collecting = false;
+static bool     batch_changed    = false;
+static uint32_t batch_pending    = 0;
+
+static bool batch_write(int8_t id, const void *data, uint16_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (!batch_collecting || trans->initiator2target_buffer_size > SPLIT_TRANSACTION_BATCH_SIZE) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+    if (length > 0) {
+        size_t len = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+        memcpy(split_trans_initiator2target_buffer(trans), data, len);
+    }
+    batch_pending |= (uint32_t)1 << id;
+    batch_changed = true;
+    return true;
+}
+
+static bool batch_read(int8_t id, void *data, uint16_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (!batch_collecting) {
+        return transport_execute_transaction(id, NULL, 0, data, length);
+    }
+    size_t len = trans->target2initiator_buffer_size < length ? trans->target2initiator_buffer_size : length;
+    memcpy(data, split_trans_target2initiator_buffer(trans), len);
+    return true;
+}
+
+#    define transport_write(id, data, length) batch_write(id, data, length)
+#    define transport_read(id, data, length) batch_read(id, data, length)
+#    define transport_exec(id) batch_write(id, NULL, 0)
+
+#else // defined(SPLIT_TRANSACTION_BATCHING)
+
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#    define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+
+#endif // defined(SPLIT_TRANSACTION_BATCHING)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -178,6 +220,163 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_EVENTS
+
+#    ifdef DISABLE_SYNC_TIMER
+#        error "SPLIT_MATRIX_EVENTS requires the sync timer"
+#    endif // DISABLE_SYNC_TIMER
+
+static uint16_t slave_matrix_event_times[(MATRIX_ROWS) / 2][MATRIX_COLS]; // when each key of the slave last changed
+
+uint16_t split_matrix_event_time(uint8_t row, uint8_t col) {
+    static uint16_t last_time = 0;
+    uint16_t        now       = timer_read();
+    uint8_t         that_hand = isLeftHand ? (MATRIX_ROWS) / 2 : 0;
+    uint16_t        time      = now;
+
+    if (row >= that_hand && row < that_hand + (MATRIX_ROWS) / 2 && col < MATRIX_COLS) {
+        time = slave_matrix_event_times[row - that_hand][col];
+        // Never hand out times from the future, nor ones earlier than the previous event, as the tap-hold logic expects
+        // events in chronological order
+        if (TIMER_DIFF_16(now, time) > TIMER_DIFF_16(now, last_time)) {
+            time = last_time;
+        }
+    }
+    last_time = time;
+    return time;
+}
+
+// Reads the full matrix and the number of events queued up to it, for when the master lost track of the events
+static bool slave_matrix_resync(matrix_row_t matrix[], uint8_t *head) {
+    uint8_t      checksum;
+    uint8_t      head_after;
+    matrix_row_t temp_matrix[(MATRIX_ROWS) / 2];
+
+    // The slave may scan between the reads, which only matters when it queued events meanwhile
+    bool okay = transport_read(GET_SLAVE_MATRIX_EVENTS_HEAD, head, sizeof(*head));
+    okay      = okay && transport_read(GET_SLAVE_MATRIX_CHECKSUM, &checksum, sizeof(checksum));
+    okay      = okay && transport_read(GET_SLAVE_MATRIX_DATA, temp_matrix, sizeof(temp_matrix));
+    okay      = okay && transport_read(GET_SLAVE_MATRIX_EVENTS_HEAD, &head_after, sizeof(head_after));
+    if (!okay || checksum != crc8(temp_matrix, sizeof(temp_matrix)) || head_after != *head) {
+        return false;
+    }
+
+    // Without events, keys that changed are stamped with the time of arrival
+    uint16_t now = timer_read();
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; ++row) {
+        matrix_row_t changes = matrix[row] ^ temp_matrix[row];
+        for (uint8_t col = 0; changes && col < MATRIX_COLS; ++col) {
+            if (changes & (MATRIX_ROW_SHIFTER << col)) {
+                slave_matrix_event_times[row][col] = now;
+            }
+        }
+    }
+    memcpy(matrix, temp_matrix, sizeof(temp_matrix));
+    return true;
+}
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t                    last_update                    = 0;
+    static matrix_row_t                last_matrix[(MATRIX_ROWS) / 2] = {0};
+    static split_slave_matrix_events_t events                         = {0};
+    static uint8_t                     tail                           = 0;
+    static bool                        synced                         = false;
+
+    bool okay = true;
+    // Also compare against the full matrix now and then, in case the events went astray
+    if (!synced || (tail == events.head && timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS)) {
+        uint8_t head;
+        okay = slave_matrix_resync(last_matrix, &head);
+        if (okay) {
+            tail = events.head = head;
+            synced             = true;
+            last_update        = timer_read32();
+        }
+    } else {
+        uint8_t head;
+        okay = transport_read(GET_SLAVE_MATRIX_EVENTS_HEAD, &head, sizeof(head));
+        if (okay && head != events.head) {
+            split_slave_matrix_events_t temp_events;
+            okay = transport_read(GET_SLAVE_MATRIX_EVENTS, &temp_events, sizeof(temp_events));
+            okay = okay && temp_events.checksum == crc8(&temp_events.head, sizeof(temp_events) - offsetof(split_slave_matrix_events_t, head));
+            if (okay) {
+                memcpy(&events, &temp_events, sizeof(temp_events));
+            }
+        }
+
+        if ((uint8_t)(events.head - tail) > SPLIT_MATRIX_EVENTS_SIZE) {
+            // Events were overwritten before the master got to them
+            synced = false;
+        } else {
+            // Merge the events in order, but only one change per key and scan, so that quick taps aren't lost
+            matrix_row_t changed[(MATRIX_ROWS) / 2] = {0};
+            for (; tail != events.head; ++tail) {
+                const split_slave_matrix_event_t *event = &events.events[tail % SPLIT_MATRIX_EVENTS_SIZE];
+                uint8_t                           row   = event->row;
+                uint8_t                           col   = event->col & ~SPLIT_MATRIX_EVENT_PRESSED;
+                if (row >= (MATRIX_ROWS) / 2 || col >= MATRIX_COLS) {
+                    continue;
+                }
+
+                matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+                if (changed[row] & mask) {
+                    break;
+                }
+                changed[row] |= mask;
+                if (event->col & SPLIT_MATRIX_EVENT_PRESSED) {
+                    last_matrix[row] |= mask;
+                } else {
+                    last_matrix[row] &= ~mask;
+                }
+                slave_matrix_event_times[row][col] = event->time;
+            }
+            if (tail == events.head) {
+                last_update = timer_read32();
+            }
+        }
+    }
+
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t          last_matrix[(MATRIX_ROWS) / 2] = {0};
+    split_slave_matrix_events_t *events                         = &split_shmem->smatrix_events;
+
+    // Queue an event for each key that changed since the previous scan
+    uint16_t now = sync_timer_read();
+    bool     queued = false;
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; ++row) {
+        matrix_row_t changes = slave_matrix[row] ^ last_matrix[row];
+        for (uint8_t col = 0; changes && col < MATRIX_COLS; ++col) {
+            matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+            if (changes & mask) {
+                split_slave_matrix_event_t *event = &events->events[events->head++ % SPLIT_MATRIX_EVENTS_SIZE];
+                event->time                       = now;
+                event->row                        = row;
+                event->col                        = col | ((slave_matrix[row] & mask) ? SPLIT_MATRIX_EVENT_PRESSED : 0);
+                changes &= ~mask;
+                queued = true;
+            }
+        }
+    }
+    memcpy(last_matrix, slave_matrix, sizeof(last_matrix));
+    if (queued) {
+        events->checksum = crc8(&events->head, sizeof(*events) - offsetof(split_slave_matrix_events_t, head));
+    }
+
+    // The full matrix is still needed whenever the master has to resynchronize
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+}
+
+#    define TRANSACTIONS_SLAVE_MATRIX_EVENTS_REGISTRATIONS \
+        [GET_SLAVE_MATRIX_EVENTS_HEAD] = trans_target2initiator_initializer(smatrix_events.head), \
+        [GET_SLAVE_MATRIX_EVENTS]      = trans_target2initiator_initializer(smatrix_events),
+
+#else // SPLIT_MATRIX_EVENTS
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -198,12 +397,17 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+#    define TRANSACTIONS_SLAVE_MATRIX_EVENTS_REGISTRATIONS
+
+#endif // SPLIT_MATRIX_EVENTS
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_EVENTS_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -242,6 +446,9 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
     static uint32_t  last_update   = 0;
     static uint8_t   last_checksum = 0;
     encoder_events_t temp_events;
+#    if defined(SPLIT_TRANSACTION_BATCHING)
+    static uint8_t last_dequeued = 0;
+#    endif // defined(SPLIT_TRANSACTION_BATCHING)
 
     bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, &temp_events, &split_shmem->encoders.events, sizeof(temp_events));
     if (okay) {
@@ -249,10 +456,18 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
             bool    actioned = false;
             uint8_t index;
             bool    clockwise;
+#    if defined(SPLIT_TRANSACTION_BATCHING)
+            // The drain only reaches the slave with the next frame, so skip any events that were already actioned
+            while ((int8_t)(last_dequeued - split_shmem->encoders.events.dequeued) > 0 && encoder_dequeue_event_advanced(&split_shmem->encoders.events, &index, &clockwise)) {
+            }
+#    endif // defined(SPLIT_TRANSACTION_BATCHING)
             while (okay && encoder_dequeue_event_advanced(&split_shmem->encoders.events, &index, &clockwise)) {
                 okay &= encoder_queue_event(index, clockwise);
                 actioned = true;
             }
+#    if defined(SPLIT_TRANSACTION_BATCHING)
+            last_dequeued = split_shmem->encoders.events.dequeued;
+#    endif // defined(SPLIT_TRANSACTION_BATCHING)
 
             if (actioned) {
                 okay &= transport_exec(CMD_ENCODER_DRAIN);
@@ -914,6 +1129,312 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Telemetry
+
+#if defined(SPLIT_TELEMETRY_ENABLE)
+
+// clang-format off
+#    define TRANSACTIONS_TELEMETRY_REGISTRATIONS \
+    [EXCHANGE_TELEMETRY] = { \
+        sizeof_member(split_shared_memory_t, telemetry.request), offsetof(split_shared_memory_t, telemetry.request), \
+        sizeof_member(split_shared_memory_t, telemetry.report), offsetof(split_shared_memory_t, telemetry.report), \
+        split_telemetry_slave_callback \
+    }, \
+    [EXCHANGE_STRESS] = { \
+        sizeof_member(split_shared_memory_t, telemetry.stress_request), offsetof(split_shared_memory_t, telemetry.stress_request), \
+        sizeof_member(split_shared_memory_t, telemetry.stress_response), offsetof(split_shared_memory_t, telemetry.stress_response), \
+        split_telemetry_slave_stress_callback \
+    },
+// clang-format on
+
+#else // defined(SPLIT_TELEMETRY_ENABLE)
+
+#    define TRANSACTIONS_TELEMETRY_REGISTRATIONS
+
+#endif // defined(SPLIT_TELEMETRY_ENABLE)
+
+////////////////////////////////////////////////////
+// Batching
+
+#if defined(SPLIT_TRANSACTION_BATCHING)
+
+static uint8_t batch_frame_checksum(const split_batch_frame_t *frame) {
+    return crc8(&frame->sequence, frame->length - offsetof(split_batch_frame_t, sequence));
+}
+
+static uint8_t batch_reply_checksum(const split_batch_reply_t *reply) {
+    return crc8((const uint8_t *)reply + sizeof(reply->checksum), sizeof(split_batch_reply_t) - sizeof(reply->checksum));
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t sequence = 0;
+    if (batch_changed) {
+        // Only retries of the same data reuse the sequence number, so the slave can tell them apart from new frames
+        sequence      = (sequence % UINT8_MAX) + 1;
+        batch_changed = false;
+    }
+
+    split_batch_frame_t frame  = {.sequence = sequence};
+    uint32_t            sent   = 0;
+    uint8_t             offset = 0;
+
+    // Pack the data of each queued up transaction, anything that doesn't fit any more is left for the next frame
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (!(batch_pending & ((uint32_t)1 << id)) || offset + trans->initiator2target_buffer_size > sizeof(frame.data)) {
+            continue;
+        }
+        memcpy(&frame.data[offset], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        offset += trans->initiator2target_buffer_size;
+        frame.sections[id / 8] |= 1 << (id % 8);
+        sent |= (uint32_t)1 << id;
+    }
+    frame.length   = offsetof(split_batch_frame_t, data) + offset;
+    frame.checksum = batch_frame_checksum(&frame);
+
+    split_batch_reply_t reply;
+    if (!transport_execute_transaction(EXCHANGE_BATCH, &frame, frame.length, &reply, sizeof(reply)) || reply.checksum != batch_reply_checksum(&reply)) {
+        return false;
+    }
+    batch_pending &= ~sent;
+    batch_changed |= batch_pending != 0;
+
+    // Hand the slave's data to the handlers, as if each had been read with its own transaction
+    memcpy(&split_shmem->smatrix, &reply.smatrix, sizeof(reply.smatrix));
+#    ifdef SPLIT_MATRIX_EVENTS
+    memcpy(&split_shmem->smatrix_events, &reply.smatrix_events, sizeof(reply.smatrix_events));
+#    endif // SPLIT_MATRIX_EVENTS
+#    ifdef ENCODER_ENABLE
+    memcpy(&split_shmem->encoders, &reply.encoders, sizeof(reply.encoders));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    split_shmem->pointing.checksum = reply.pointing.checksum;
+    split_shmem->pointing.report   = reply.pointing.report;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    return true;
+}
+
+static void batch_handlers_slave_exchange(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static uint8_t             last_sequence = 0;
+    const split_batch_frame_t *frame         = &split_shmem->batch_frame;
+
+    // Unpack each section to where its own transaction would have put it, for the slave handlers to act upon. Retries of
+    // a frame that was already unpacked are skipped, so that callbacks are only executed once.
+    if (frame->length >= offsetof(split_batch_frame_t, data) && frame->length <= sizeof(split_batch_frame_t) && frame->sequence != last_sequence && frame->checksum == batch_frame_checksum(frame)) {
+        uint8_t length = frame->length - offsetof(split_batch_frame_t, data);
+        uint8_t offset = 0;
+        for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (!(frame->sections[id / 8] & (1 << (id % 8)))) {
+                continue;
+            }
+            if (id == EXCHANGE_BATCH || offset + trans->initiator2target_buffer_size > length) {
+                break;
+            }
+            memcpy(split_trans_initiator2target_buffer(trans), &frame->data[offset], trans->initiator2target_buffer_size);
+            offset += trans->initiator2target_buffer_size;
+            if (trans->slave_callback) {
+                trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+            }
+        }
+        last_sequence = frame->sequence;
+    }
+
+    // Prepare the reply from what the slave handlers last left in shared memory
+    split_batch_reply_t *reply = &split_shmem->batch_reply;
+    memcpy(&reply->smatrix, &split_shmem->smatrix, sizeof(reply->smatrix));
+#    ifdef SPLIT_MATRIX_EVENTS
+    memcpy(&reply->smatrix_events, &split_shmem->smatrix_events, sizeof(reply->smatrix_events));
+#    endif // SPLIT_MATRIX_EVENTS
+#    ifdef ENCODER_ENABLE
+    memcpy(&reply->encoders, &split_shmem->encoders, sizeof(reply->encoders));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    memcpy(&reply->pointing, &split_shmem->pointing, sizeof(reply->pointing));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->checksum = batch_reply_checksum(reply);
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH] = { \
+        sizeof_member(split_shared_memory_t, batch_frame), offsetof(split_shared_memory_t, batch_frame), \
+        sizeof_member(split_shared_memory_t, batch_reply), offsetof(split_shared_memory_t, batch_reply), \
+        batch_handlers_slave_exchange, true \
+    },
+// clang-format on
+
+#else // defined(SPLIT_TRANSACTION_BATCHING)
+
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // defined(SPLIT_TRANSACTION_BATCHING)
+
+////////////////////////////////////////////////////
+// RPC streaming
+
+#if defined(SPLIT_RPC_STREAMING)
+
+_Static_assert((SPLIT_RPC_STREAM_BUFFER_SIZE & (SPLIT_RPC_STREAM_BUFFER_SIZE - 1)) == 0 && SPLIT_RPC_STREAM_BUFFER_SIZE <= 32768, "SPLIT_RPC_STREAM_BUFFER_SIZE must be a power of two, up to 32768");
+_Static_assert(SPLIT_RPC_STREAM_FRAME_SIZE > SPLIT_RPC_STREAM_RECORD_HEADER_SIZE, "SPLIT_RPC_STREAM_FRAME_SIZE too small");
+_Static_assert(SPLIT_RPC_STREAM_BUFFER_SIZE >= SPLIT_RPC_STREAM_FRAME_SIZE, "SPLIT_RPC_STREAM_BUFFER_SIZE must be able to hold a whole frame");
+
+// Streamed messages can only be sent to keyboard and user transaction IDs
+#    define RPC_STREAM_FIRST_ID (GET_RPC_RESP_DATA + 1)
+
+static split_rpc_stream_callback_t rpc_stream_callbacks[NUM_TOTAL_TRANSACTIONS - RPC_STREAM_FIRST_ID];
+
+// Master: the frame records are queued up in, and the slave's free space as of its last reply. Once the frame has
+// been sent, it has a sequence number and is kept as it is until the slave acknowledges it.
+static split_rpc_stream_frame_t rpc_stream_pending = {.length = offsetof(split_rpc_stream_frame_t, data)};
+static uint8_t                  rpc_stream_space   = UINT8_MAX;
+
+// Slave: accepted records, added by the transport and removed by the slave handler
+static uint8_t           rpc_stream_buffer[SPLIT_RPC_STREAM_BUFFER_SIZE];
+static volatile uint16_t rpc_stream_head = 0;
+static volatile uint16_t rpc_stream_tail = 0;
+
+static uint8_t rpc_stream_frame_checksum(const split_rpc_stream_frame_t *frame) {
+    return crc8(&frame->sequence, frame->length - offsetof(split_rpc_stream_frame_t, sequence));
+}
+
+static uint8_t rpc_stream_reply_checksum(const split_rpc_stream_reply_t *reply) {
+    return crc8((const uint8_t *)reply + sizeof(reply->checksum), sizeof(split_rpc_stream_reply_t) - sizeof(reply->checksum));
+}
+
+// Sends the queued up frame, waiting up to `timeout` for the slave to make room for it. A frame that wasn't
+// acknowledged in time stays queued, and is sent again by the next call.
+static bool rpc_stream_transmit(uint32_t timeout) {
+    static uint8_t sequence = 0;
+    uint8_t        length   = rpc_stream_pending.length - offsetof(split_rpc_stream_frame_t, data);
+    if (length == 0) {
+        return true;
+    }
+
+    if (rpc_stream_pending.sequence == 0) {
+        sequence                    = (sequence % UINT8_MAX) + 1;
+        rpc_stream_pending.sequence = sequence;
+        rpc_stream_pending.checksum = rpc_stream_frame_checksum(&rpc_stream_pending);
+    }
+
+    split_rpc_stream_frame_t poll = {.length = offsetof(split_rpc_stream_frame_t, data)};
+    poll.checksum                 = rpc_stream_frame_checksum(&poll);
+
+    bool     okay  = false;
+    uint32_t start = timer_read32();
+    do {
+        // While the slave is short on space, only ask for its state until it has caught up
+        const split_rpc_stream_frame_t *frame = rpc_stream_space >= length ? &rpc_stream_pending : &poll;
+        split_rpc_stream_reply_t        reply;
+        if (!transport_execute_transaction(EXCHANGE_RPC_STREAM, frame, frame->length, &reply, sizeof(reply)) || reply.checksum != rpc_stream_reply_checksum(&reply)) {
+            continue;
+        }
+        rpc_stream_space = reply.space;
+        okay             = reply.ack == rpc_stream_pending.sequence;
+    } while (!okay && is_transport_connected() && timer_elapsed32(start) < timeout);
+
+    if (okay) {
+        rpc_stream_pending.length   = offsetof(split_rpc_stream_frame_t, data);
+        rpc_stream_pending.sequence = 0;
+    }
+    return okay;
+}
+
+static void rpc_stream_handlers_slave_exchange(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static uint8_t                  last_sequence = 0;
+    const split_rpc_stream_frame_t *frame         = &split_shmem->rpc_stream_frame;
+    uint16_t                        space         = SPLIT_RPC_STREAM_BUFFER_SIZE - (uint16_t)(rpc_stream_head - rpc_stream_tail);
+
+    // Frames are only accepted whole, and the master keeps sending them until they are. Retries of a frame that was
+    // already accepted are skipped.
+    if (frame->length >= offsetof(split_rpc_stream_frame_t, data) && frame->length <= sizeof(split_rpc_stream_frame_t) && frame->sequence != 0 && frame->sequence != last_sequence && frame->checksum == rpc_stream_frame_checksum(frame)) {
+        uint8_t length = frame->length - offsetof(split_rpc_stream_frame_t, data);
+        if (length <= space) {
+            uint16_t head = rpc_stream_head;
+            for (uint8_t i = 0; i < length; ++i) {
+                rpc_stream_buffer[(uint16_t)(head + i) % SPLIT_RPC_STREAM_BUFFER_SIZE] = frame->data[i];
+            }
+            rpc_stream_head = head + length;
+            space -= length;
+            last_sequence = frame->sequence;
+        }
+    }
+
+    split_rpc_stream_reply_t *reply = &split_shmem->rpc_stream_reply;
+    reply->ack                      = last_sequence;
+    reply->space                    = space < UINT8_MAX ? space : UINT8_MAX;
+    reply->checksum                 = rpc_stream_reply_checksum(reply);
+}
+
+static void rpc_stream_deliver(uint8_t transaction_id, uint32_t offset, uint8_t length, const void *data, bool complete) {
+    if (transaction_id >= RPC_STREAM_FIRST_ID && transaction_id < NUM_TOTAL_TRANSACTIONS && rpc_stream_callbacks[transaction_id - RPC_STREAM_FIRST_ID]) {
+        rpc_stream_callbacks[transaction_id - RPC_STREAM_FIRST_ID](offset, length, data, complete);
+    }
+}
+
+// Hands the accepted records to their callbacks, outside of the transport so that these may take their time
+static void rpc_stream_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t offset     = 0;
+    static int8_t   incomplete = -1; // transaction ID of the message still waiting for its last record
+    uint8_t         data[SPLIT_RPC_STREAM_FRAME_SIZE];
+    uint16_t        head, tail = rpc_stream_tail;
+    ATOMIC_BLOCK_FORCEON {
+        head = rpc_stream_head;
+    }
+
+    while ((uint16_t)(head - tail) >= SPLIT_RPC_STREAM_RECORD_HEADER_SIZE) {
+        uint8_t id     = rpc_stream_buffer[tail % SPLIT_RPC_STREAM_BUFFER_SIZE];
+        uint8_t length = rpc_stream_buffer[(uint16_t)(tail + 1) % SPLIT_RPC_STREAM_BUFFER_SIZE];
+        if (length > (uint16_t)(head - tail) - SPLIT_RPC_STREAM_RECORD_HEADER_SIZE || length > sizeof(data)) {
+            // Malformed, drop everything rather than lose track of where records start
+            ATOMIC_BLOCK_FORCEON {
+                rpc_stream_tail = head;
+            }
+            return;
+        }
+        for (uint8_t i = 0; i < length; ++i) {
+            data[i] = rpc_stream_buffer[(uint16_t)(tail + SPLIT_RPC_STREAM_RECORD_HEADER_SIZE + i) % SPLIT_RPC_STREAM_BUFFER_SIZE];
+        }
+        // Make room for the master right away, the callback may take a while
+        tail += SPLIT_RPC_STREAM_RECORD_HEADER_SIZE + length;
+        ATOMIC_BLOCK_FORCEON {
+            rpc_stream_tail = tail;
+        }
+
+        uint8_t transaction_id = id & SPLIT_RPC_STREAM_ID_MASK;
+        if (id & SPLIT_RPC_STREAM_FIRST) {
+            // The master gave up on the previous message part way through
+            if (incomplete >= 0) {
+                rpc_stream_deliver(incomplete, offset, 0, NULL, false);
+            }
+            offset = 0;
+        }
+        rpc_stream_deliver(transaction_id, offset, length, data, id & SPLIT_RPC_STREAM_LAST);
+        incomplete = (id & SPLIT_RPC_STREAM_LAST) ? -1 : transaction_id;
+        offset += length;
+    }
+}
+
+#    define TRANSACTIONS_RPC_STREAM_MASTER() rpc_stream_transmit(0)
+#    define TRANSACTIONS_RPC_STREAM_SLAVE() TRANSACTION_HANDLER_SLAVE(rpc_stream)
+// clang-format off
+#    define TRANSACTIONS_RPC_STREAM_REGISTRATIONS \
+    [EXCHANGE_RPC_STREAM] = { \
+        sizeof_member(split_shared_memory_t, rpc_stream_frame), offsetof(split_shared_memory_t, rpc_stream_frame), \
+        sizeof_member(split_shared_memory_t, rpc_stream_reply), offsetof(split_shared_memory_t, rpc_stream_reply), \
+        rpc_stream_handlers_slave_exchange, true \
+    },
+// clang-format on
+
+#else // defined(SPLIT_RPC_STREAMING)
+
+#    define TRANSACTIONS_RPC_STREAM_MASTER()
+#    define TRANSACTIONS_RPC_STREAM_SLAVE()
+#    define TRANSACTIONS_RPC_STREAM_REGISTRATIONS
+
+#endif // defined(SPLIT_RPC_STREAMING)
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -944,6 +1465,9 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_TELEMETRY_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
+    TRANSACTIONS_RPC_STREAM_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -954,6 +1478,50 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+#if defined(SPLIT_TRANSACTION_BATCHING)
+
+static bool transactions_master_batched(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Queue up everything sent to the slave...
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+
+    // ...exchange it for the slave's state in a single transaction...
+    bool okay = transaction_handler_master(master_matrix, slave_matrix, "batch", &batch_handlers_master);
+
+    // ...and process that. Should the exchange fail, the last known good slave matrix is still used.
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    if (!okay) {
+        return false;
+    }
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    return true;
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    batch_collecting = true;
+    bool okay        = transactions_master_batched(master_matrix, slave_matrix);
+    batch_collecting = false;
+    TRANSACTIONS_RPC_STREAM_MASTER();
+    return okay;
+}
+
+#else // defined(SPLIT_TRANSACTION_BATCHING)
+
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
@@ -974,9 +1542,12 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_STREAM_MASTER();
     return true;
 }
 
+#endif // defined(SPLIT_TRANSACTION_BATCHING)
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -997,6 +1568,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_RPC_STREAM_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -1076,4 +1648,60 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 }
 
+#if defined(SPLIT_RPC_STREAMING)
+
+void transaction_register_rpc_stream(int8_t transaction_id, split_rpc_stream_callback_t callback) {
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id < RPC_STREAM_FIRST_ID || transaction_id >= NUM_TOTAL_TRANSACTIONS) return;
+
+    rpc_stream_callbacks[transaction_id - RPC_STREAM_FIRST_ID] = callback;
+}
+
+bool transaction_rpc_stream(int8_t transaction_id, const void *data, uint32_t length) {
+    // Prevent transaction attempts while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id < RPC_STREAM_FIRST_ID || transaction_id >= NUM_TOTAL_TRANSACTIONS) return false;
+
+    // Cut the message into records, each taking up as much of the frame as is left. Small messages share a frame with
+    // whatever else is queued up, large ones are spread across as many frames as needed.
+    const uint8_t *source = (const uint8_t *)data;
+    uint8_t        flags  = SPLIT_RPC_STREAM_FIRST;
+    do {
+        // A frame that was already sent can't take any more records, the slave may have accepted it as it was
+        uint8_t room = rpc_stream_pending.sequence == 0 ? sizeof(rpc_stream_pending) - rpc_stream_pending.length : 0;
+        if (room < SPLIT_RPC_STREAM_RECORD_HEADER_SIZE + (length > 0 ? 1 : 0)) {
+            if (!rpc_stream_transmit(SPLIT_RPC_STREAM_TIMEOUT)) {
+                return false;
+            }
+            continue;
+        }
+
+        uint8_t chunk = room - SPLIT_RPC_STREAM_RECORD_HEADER_SIZE;
+        if (length <= chunk) {
+            chunk = length;
+            flags |= SPLIT_RPC_STREAM_LAST;
+        }
+        uint8_t *record = (uint8_t *)&rpc_stream_pending + rpc_stream_pending.length;
+        record[0]       = transaction_id | flags;
+        record[1]       = chunk;
+        memcpy(&record[SPLIT_RPC_STREAM_RECORD_HEADER_SIZE], source, chunk);
+        rpc_stream_pending.length += SPLIT_RPC_STREAM_RECORD_HEADER_SIZE + chunk;
+
+        source += chunk;
+        length -= chunk;
+        flags &= ~SPLIT_RPC_STREAM_FIRST;
+    } while (!(flags & SPLIT_RPC_STREAM_LAST));
+
+    return true;
+}
+
+bool transaction_rpc_stream_flush(void) {
+    return rpc_stream_transmit(SPLIT_RPC_STREAM_TIMEOUT);
+}
+
+#endif // defined(SPLIT_RPC_STREAMING)
+
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
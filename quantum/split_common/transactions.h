@@ -32,6 +32,7 @@ typedef struct _split_transaction_desc_t {
     uint8_t          target2initiator_buffer_size;
     uint16_t         target2initiator_offset;
     slave_callback_t slave_callback;
+    bool             initiator2target_length_prefixed;
 } split_transaction_desc_t;
 
 // Forward declaration for the split transactions
@@ -41,6 +42,16 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 #define split_trans_initiator2target_buffer(trans) (split_shmem_offset_ptr((trans)->initiator2target_offset))
 #define split_trans_target2initiator_buffer(trans) (split_shmem_offset_ptr((trans)->target2initiator_offset))
 
+// Number of initiator2target bytes transferred. Length prefixed buffers only send as much as their first byte says,
+// so after receiving the first byte this needs to be re-evaluated.
+static inline uint8_t split_trans_initiator2target_length(const split_transaction_desc_t *trans) {
+    if (!trans->initiator2target_length_prefixed) {
+        return trans->initiator2target_buffer_size;
+    }
+    uint8_t length = split_trans_initiator2target_buffer(trans)[0];
+    return length < 1 ? 1 : (length > trans->initiator2target_buffer_size ? trans->initiator2target_buffer_size : length);
+}
+
 // returns false if valid data not received from slave
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
@@ -51,3 +62,20 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#if defined(SPLIT_RPC_STREAMING)
+// Invoked on the slave for each fragment of a streamed message, in order. `offset` is the position of the fragment
+// within its message, and `complete` is set for its last fragment. Should the master abandon a message part way
+// through, the callback is invoked once more with `data` set to NULL, when the next message starts.
+typedef void (*split_rpc_stream_callback_t)(uint32_t offset, uint8_t length, const void *data, bool complete);
+
+void transaction_register_rpc_stream(int8_t transaction_id, split_rpc_stream_callback_t callback);
+
+// Queues up a message of any length for the slave, sending frames as they fill up. Returns false if the slave could
+// not be reached, in which case only the first part of the message was queued. Queued data is kept until the slave
+// accepts it.
+bool transaction_rpc_stream(int8_t transaction_id, const void *data, uint32_t length);
+
+// Sends whatever is queued up right away, instead of with the next scan.
+bool transaction_rpc_stream_flush(void);
+#endif // defined(SPLIT_RPC_STREAMING)
@@ -57,6 +57,28 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_MATRIX_EVENTS
+#    ifndef SPLIT_MATRIX_EVENTS_SIZE
+#        define SPLIT_MATRIX_EVENTS_SIZE 8
+#    endif // SPLIT_MATRIX_EVENTS_SIZE
+
+#    define SPLIT_MATRIX_EVENT_PRESSED 0x80
+
+typedef struct _split_slave_matrix_event_t {
+    uint16_t time; // sync_timer_read() of the slave when the key changed
+    uint8_t  row;
+    uint8_t  col; // SPLIT_MATRIX_EVENT_PRESSED is set for presses
+} split_slave_matrix_event_t;
+
+typedef struct _split_slave_matrix_events_t {
+    uint8_t                    checksum; // crc8 of the rest of the struct
+    uint8_t                    head;     // events queued so far, wrapping around
+    split_slave_matrix_event_t events[SPLIT_MATRIX_EVENTS_SIZE];
+} split_slave_matrix_events_t;
+
+_Static_assert((SPLIT_MATRIX_EVENTS_SIZE & (SPLIT_MATRIX_EVENTS_SIZE - 1)) == 0 && SPLIT_MATRIX_EVENTS_SIZE <= 128, "SPLIT_MATRIX_EVENTS_SIZE must be a power of two, up to 128");
+#endif // SPLIT_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -143,10 +165,103 @@ typedef struct _rpc_sync_info_t {
 } rpc_sync_info_t;
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#if defined(SPLIT_RPC_STREAMING)
+#    if !defined(SPLIT_TRANSACTION_IDS_KB) && !defined(SPLIT_TRANSACTION_IDS_USER)
+#        error "SPLIT_RPC_STREAMING requires SPLIT_TRANSACTION_IDS_KB or SPLIT_TRANSACTION_IDS_USER"
+#    endif
+
+#    ifndef SPLIT_RPC_STREAM_FRAME_SIZE
+#        define SPLIT_RPC_STREAM_FRAME_SIZE 64
+#    endif // SPLIT_RPC_STREAM_FRAME_SIZE
+
+#    ifndef SPLIT_RPC_STREAM_BUFFER_SIZE
+#        define SPLIT_RPC_STREAM_BUFFER_SIZE 256
+#    endif // SPLIT_RPC_STREAM_BUFFER_SIZE
+
+#    ifndef SPLIT_RPC_STREAM_TIMEOUT
+#        define SPLIT_RPC_STREAM_TIMEOUT 100
+#    endif // SPLIT_RPC_STREAM_TIMEOUT
+
+// Each record in a frame is a transaction ID combined with these flags, its length, and that much data
+#    define SPLIT_RPC_STREAM_FIRST 0x80 // the record starts a message
+#    define SPLIT_RPC_STREAM_LAST 0x40  // the record completes a message
+#    define SPLIT_RPC_STREAM_ID_MASK 0x1F
+#    define SPLIT_RPC_STREAM_RECORD_HEADER_SIZE 2
+
+typedef struct _split_rpc_stream_frame_t {
+    uint8_t length;   // bytes of the frame in use, including this header
+    uint8_t checksum; // crc8 of the rest of the frame
+    uint8_t sequence; // 0 for frames that only ask for the slave's state
+    uint8_t data[SPLIT_RPC_STREAM_FRAME_SIZE];
+} split_rpc_stream_frame_t;
+
+_Static_assert(sizeof(split_rpc_stream_frame_t) <= UINT8_MAX, "SPLIT_RPC_STREAM_FRAME_SIZE too large");
+
+typedef struct _split_rpc_stream_reply_t {
+    uint8_t checksum;
+    uint8_t ack;   // sequence of the last frame accepted
+    uint8_t space; // free space in the slave's stream buffer, saturated
+} split_rpc_stream_reply_t;
+#endif // defined(SPLIT_RPC_STREAMING)
+
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#if defined(SPLIT_TELEMETRY_ENABLE)
+#    include "split_telemetry.h"
+
+typedef struct _split_telemetry_request_t {
+    uint8_t id;    // transaction ID to report on
+    uint8_t reset; // changed by the master every time the statistics are to be cleared
+} split_telemetry_request_t;
+
+typedef struct _split_telemetry_report_t {
+    split_telemetry_request_t  request; // the request this report answers
+    split_telemetry_stats_t    stats;
+    split_telemetry_counters_t counters;
+} split_telemetry_report_t;
+
+typedef struct _split_telemetry_sync_t {
+    split_telemetry_request_t request;
+    split_telemetry_report_t  report;
+    uint8_t                  stress_request[SPLIT_TELEMETRY_STRESS_SIZE];
+    uint8_t                  stress_response[SPLIT_TELEMETRY_STRESS_SIZE];
+} split_telemetry_sync_t;
+#endif // defined(SPLIT_TELEMETRY_ENABLE)
+
+#if defined(SPLIT_TRANSACTION_BATCHING)
+#    include "transaction_id_define.h"
+
+#    ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#        define SPLIT_TRANSACTION_BATCH_SIZE 64
+#    endif // SPLIT_TRANSACTION_BATCH_SIZE
+
+typedef struct _split_batch_frame_t {
+    uint8_t length;   // bytes of the frame in use, including this header
+    uint8_t checksum; // crc8 of the rest of the frame
+    uint8_t sequence;
+    uint8_t sections[(NUM_TOTAL_TRANSACTIONS + 7) / 8]; // transactions whose data follows, in ascending order
+    uint8_t data[SPLIT_TRANSACTION_BATCH_SIZE];
+} split_batch_frame_t;
+
+_Static_assert(sizeof(split_batch_frame_t) <= UINT8_MAX, "SPLIT_TRANSACTION_BATCH_SIZE too large");
+
+typedef struct _split_batch_reply_t {
+    uint8_t                   checksum;
+    split_slave_matrix_sync_t smatrix;
+#    ifdef SPLIT_MATRIX_EVENTS
+    split_slave_matrix_events_t smatrix_events;
+#    endif // SPLIT_MATRIX_EVENTS
+#    ifdef ENCODER_ENABLE
+    split_slave_encoder_sync_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    split_slave_pointing_sync_t pointing;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_reply_t;
+#endif // defined(SPLIT_TRANSACTION_BATCHING)
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -154,6 +269,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_MATRIX_EVENTS
+    split_slave_matrix_events_t smatrix_events;
+#endif // SPLIT_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -222,12 +341,26 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#if defined(SPLIT_TELEMETRY_ENABLE)
+    split_telemetry_sync_t telemetry;
+#endif // defined(SPLIT_TELEMETRY_ENABLE)
+
+#if defined(SPLIT_TRANSACTION_BATCHING)
+    split_batch_frame_t batch_frame;
+    split_batch_reply_t batch_reply;
+#endif // defined(SPLIT_TRANSACTION_BATCHING)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#if defined(SPLIT_RPC_STREAMING)
+    split_rpc_stream_frame_t rpc_stream_frame;
+    split_rpc_stream_reply_t rpc_stream_reply;
+#endif // defined(SPLIT_RPC_STREAMING)
+
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
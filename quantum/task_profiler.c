@@ -0,0 +1,120 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_profiler.h"
+#include "timer.h"
+#include "debug.h"
+#include "print.h"
+
+typedef struct task_profiler_state_t {
+    uint32_t samples[TASK_PROFILER_SAMPLE_COUNT];
+    uint64_t total;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint8_t  head;
+} task_profiler_state_t;
+
+static task_profiler_state_t profiler_state[TASK_PROFILER_STAGE_COUNT];
+
+static const char *const stage_names[TASK_PROFILER_STAGE_COUNT] = {
+    [TASK_PROFILER_KEYBOARD_TASK]        = "keyboard_task",
+    [TASK_PROFILER_MATRIX_TASK]          = "matrix_task",
+    [TASK_PROFILER_QUANTUM_TASK]         = "quantum_task",
+    [TASK_PROFILER_RGBLIGHT_TASK]        = "rgblight_task",
+    [TASK_PROFILER_LED_MATRIX_TASK]      = "led_matrix_task",
+    [TASK_PROFILER_RGB_MATRIX_TASK]      = "rgb_matrix_task",
+    [TASK_PROFILER_ENCODER_TASK]         = "encoder_task",
+    [TASK_PROFILER_POINTING_DEVICE_TASK] = "pointing_device_task",
+    [TASK_PROFILER_DEFERRED_EXEC_TASK]   = "deferred_exec_task",
+    [TASK_PROFILER_HOUSEKEEPING_TASK]    = "housekeeping_task",
+};
+
+void task_profiler_record(task_profiler_stage_t stage, uint32_t ticks) {
+    if (stage >= TASK_PROFILER_STAGE_COUNT) {
+        return;
+    }
+
+    task_profiler_state_t *state = &profiler_state[stage];
+    if (state->count == 0 || ticks < state->min) {
+        state->min = ticks;
+    }
+    if (state->count == 0 || ticks > state->max) {
+        state->max = ticks;
+    }
+    if (state->count < UINT32_MAX) {
+        ++state->count;
+    }
+    state->total += ticks;
+
+    state->samples[state->head] = ticks;
+    if (++state->head >= TASK_PROFILER_SAMPLE_COUNT) {
+        state->head = 0;
+    }
+}
+
+bool task_profiler_get_stats(task_profiler_stage_t stage, task_profiler_stats_t *stats) {
+    if (stage >= TASK_PROFILER_STAGE_COUNT || stats == NULL) {
+        return false;
+    }
+
+    const task_profiler_state_t *state = &profiler_state[stage];
+    memset(stats, 0, sizeof(task_profiler_stats_t));
+    if (state->count == 0) {
+        return true;
+    }
+
+    stats->count = state->count;
+    stats->min   = state->min;
+    stats->max   = state->max;
+    stats->total = state->total;
+
+    // Only the ring buffer window participates in the percentile calculation -- sort a copy of it
+    uint8_t  window = state->count < TASK_PROFILER_SAMPLE_COUNT ? (uint8_t)state->count : TASK_PROFILER_SAMPLE_COUNT;
+    uint32_t sorted[TASK_PROFILER_SAMPLE_COUNT];
+    for (uint8_t i = 0; i < window; ++i) {
+        uint32_t value = state->samples[i];
+        uint8_t  j     = i;
+        for (; j > 0 && sorted[j - 1] > value; --j) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+
+    // Nearest-rank percentiles
+    stats->p50 = sorted[(window + 1) / 2 - 1];
+    stats->p99 = sorted[((uint16_t)window * 99 + 99) / 100 - 1];
+    return true;
+}
+
+const char *task_profiler_stage_name(task_profiler_stage_t stage) {
+    if (stage >= TASK_PROFILER_STAGE_COUNT) {
+        return "unknown";
+    }
+    return stage_names[stage];
+}
+
+void task_profiler_reset(void) {
+    memset(profiler_state, 0, sizeof(profiler_state));
+}
+
+void task_profiler_print(void) {
+    for (task_profiler_stage_t stage = 0; stage < TASK_PROFILER_STAGE_COUNT; ++stage) {
+        task_profiler_stats_t stats;
+        if (!task_profiler_get_stats(stage, &stats) || stats.count == 0) {
+            continue;
+        }
+        dprintf("%s -- n:%lu min:%lu p50:%lu p99:%lu max:%lu\n", task_profiler_stage_name(stage), stats.count, stats.min, stats.p50, stats.p99, stats.max);
+    }
+}
+
+void task_profiler_task(void) {
+#if defined(TASK_PROFILER_PRINT_INTERVAL) && TASK_PROFILER_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= TASK_PROFILER_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        task_profiler_print();
+    }
+#endif // defined(TASK_PROFILER_PRINT_INTERVAL) && TASK_PROFILER_PRINT_INTERVAL > 0
+}
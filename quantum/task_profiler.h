@@ -0,0 +1,115 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Task profiler -- records how long each stage of the main loop takes.
+
+    Each stage keeps an all-time minimum/maximum as well as a ring buffer of the most recent
+    TASK_PROFILER_SAMPLE_COUNT durations, which is used to derive the median and 99th percentile
+    when statistics are requested. Durations are measured in platform-specific ticks, as returned
+    by task_profiler_ticks():
+
+        AVR:     timer0 ticks (F_CPU / 64)
+        ChibiOS: realtime counter (usually CPU cycles), falling back to system ticks
+        Test:    microseconds of mocked time, or nanoseconds of host time with TASK_PROFILER_HOST_CLOCK
+
+    Usage example:
+
+        #include "task_profiler.h"
+
+        TASK_PROFILER_CALL(TASK_PROFILER_MATRIX_TASK, matrix_task());
+*/
+
+#ifndef TASK_PROFILER_SAMPLE_COUNT
+#    define TASK_PROFILER_SAMPLE_COUNT 32
+#endif
+
+#if TASK_PROFILER_SAMPLE_COUNT > 255
+#    error TASK_PROFILER_SAMPLE_COUNT must be less than 256
+#endif
+
+typedef enum task_profiler_stage_t {
+    TASK_PROFILER_KEYBOARD_TASK,
+    TASK_PROFILER_MATRIX_TASK,
+    TASK_PROFILER_QUANTUM_TASK,
+    TASK_PROFILER_RGBLIGHT_TASK,
+    TASK_PROFILER_LED_MATRIX_TASK,
+    TASK_PROFILER_RGB_MATRIX_TASK,
+    TASK_PROFILER_ENCODER_TASK,
+    TASK_PROFILER_POINTING_DEVICE_TASK,
+    TASK_PROFILER_DEFERRED_EXEC_TASK,
+    TASK_PROFILER_HOUSEKEEPING_TASK,
+    TASK_PROFILER_STAGE_COUNT,
+} task_profiler_stage_t;
+
+typedef struct task_profiler_stats_t {
+    uint32_t count; // number of samples recorded since the last reset
+    uint32_t min;   // all-time minimum since the last reset
+    uint32_t max;   // all-time maximum since the last reset
+    uint32_t p50;   // median of the most recent samples
+    uint32_t p99;   // 99th percentile of the most recent samples
+    uint64_t total; // sum of all samples since the last reset
+} task_profiler_stats_t;
+
+/**
+ * Reads the platform's high-resolution timestamp. Implemented per-platform.
+ */
+uint32_t task_profiler_ticks(void);
+
+/**
+ * Number of timestamp ticks per millisecond. Implemented per-platform.
+ */
+uint32_t task_profiler_ticks_per_ms(void);
+
+/**
+ * Records a single duration for the given stage.
+ */
+void task_profiler_record(task_profiler_stage_t stage, uint32_t ticks);
+
+/**
+ * Retrieves the statistics for the given stage.
+ *
+ * @return false if the stage is invalid
+ */
+bool task_profiler_get_stats(task_profiler_stage_t stage, task_profiler_stats_t *stats);
+
+/**
+ * Human-readable name for the given stage.
+ */
+const char *task_profiler_stage_name(task_profiler_stage_t stage);
+
+/**
+ * Clears all recorded samples.
+ */
+void task_profiler_reset(void);
+
+/**
+ * Dumps the statistics of every stage with recorded samples to the console.
+ */
+void task_profiler_print(void);
+
+/**
+ * Periodic task, prints the statistics every TASK_PROFILER_PRINT_INTERVAL milliseconds if configured.
+ */
+void task_profiler_task(void);
+
+#ifdef TASK_PROFILER_ENABLE
+#    define TASK_PROFILER_CALL(stage, call)                                               \
+        do {                                                                              \
+            uint32_t task_profiler_start__ = task_profiler_ticks();                       \
+            do {                                                                          \
+                call;                                                                     \
+            } while (0);                                                                  \
+            task_profiler_record((stage), task_profiler_ticks() - task_profiler_start__); \
+        } while (0)
+#else
+#    define TASK_PROFILER_CALL(stage, call) \
+        do {                                \
+            call;                           \
+        } while (0)
+#endif // TASK_PROFILER_ENABLE
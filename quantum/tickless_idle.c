@@ -0,0 +1,86 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+#include "quantum.h"
+
+static uint32_t last_wake          = 0;
+static uint32_t requested_wake     = 0;
+static bool     has_requested_wake = false;
+
+static inline void earliest(uint32_t *deadline, uint32_t candidate) {
+    if ((int32_t)TIMER_DIFF_32(candidate, *deadline) < 0) {
+        *deadline = candidate;
+    }
+}
+
+void tickless_idle_wake_at(uint32_t time) {
+    if (!has_requested_wake) {
+        requested_wake     = time;
+        has_requested_wake = true;
+    } else {
+        earliest(&requested_wake, time);
+    }
+}
+
+uint32_t tickless_idle_next_deadline(void) {
+    uint32_t deadline = timer_read32() + TICKLESS_IDLE_MAX_SLEEP;
+    uint32_t candidate;
+
+#ifdef MATRIX_IDLE_SCANS
+    if (!matrix_idle_interrupt_armed())
+#endif
+    {
+        earliest(&deadline, last_wake + TICKLESS_IDLE_SCAN_INTERVAL);
+    }
+
+#ifndef NO_ACTION_TAPPING
+    if (action_tapping_next_deadline(&candidate)) {
+        earliest(&deadline, candidate);
+    }
+#endif
+
+#ifdef COMBO_ENABLE
+    if (combo_next_deadline(&candidate)) {
+        earliest(&deadline, candidate);
+    }
+#endif
+
+#ifdef DEFERRED_EXEC_ENABLE
+    if (deferred_exec_next_trigger(&candidate)) {
+        earliest(&deadline, candidate);
+    }
+#endif
+
+#ifdef QUANTUM_PAINTER_ENABLE
+    bool qp_internal_next_deadline(uint32_t *deadline);
+    if (qp_internal_next_deadline(&candidate)) {
+        earliest(&deadline, candidate);
+    }
+#endif
+
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_next_deadline(&candidate)) {
+        earliest(&deadline, candidate);
+    }
+#endif
+
+    if (has_requested_wake) {
+        earliest(&deadline, requested_wake);
+    }
+
+    return deadline;
+}
+
+uint32_t tickless_idle_task(void) {
+    uint32_t now       = timer_read32();
+    int32_t  remaining = TIMER_DIFF_32(tickless_idle_next_deadline(), now);
+    has_requested_wake = false;
+
+    if (remaining > 0) {
+        tickless_idle_sleep(remaining);
+    }
+
+    last_wake = timer_read32();
+    return TIMER_DIFF_32(last_wake, now);
+}
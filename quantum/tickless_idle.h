@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Tickless idle -- sleeps at the end of each pass of the main loop until the next point in time
+    at which there is work to do, rather than spinning.
+
+    The deadline is the earliest of:
+
+        matrix:        the next matrix scan, TICKLESS_IDLE_SCAN_INTERVAL after the previous pass
+        tapping:       the tapping term of the pending tap-hold key
+        combos:        the combo term of the partially pressed combo
+        deferred exec: the next deferred executor, including Quantum Painter animations
+        rgb matrix:    the next frame, RGB_MATRIX_LED_FLUSH_LIMIT after the previous one
+        requests:      any time passed to tickless_idle_wake_at() during the pass
+
+    Sleeps are capped at TICKLESS_IDLE_MAX_SLEEP, which bounds the latency of anything polled by
+    the main loop that doesn't report a deadline. tickless_idle_wake() ends a sleep early, e.g. from
+    a pin change interrupt.
+*/
+
+#ifndef TICKLESS_IDLE_SCAN_INTERVAL
+#    define TICKLESS_IDLE_SCAN_INTERVAL 1
+#endif
+
+#ifndef TICKLESS_IDLE_MAX_SLEEP
+#    define TICKLESS_IDLE_MAX_SLEEP 20
+#endif
+
+/**
+ * Requests that the current sleep, or the next one, ends no later than the given time.
+ *
+ * @param time the time to wake up at -- equivalent time-space as timer_read32()
+ */
+void tickless_idle_wake_at(uint32_t time);
+
+/**
+ * Computes the next deadline, sleeping until then. Called at the end of each pass of the main loop.
+ * Should not be invoked by keyboard/user code.
+ *
+ * @return the number of milliseconds slept for
+ */
+uint32_t tickless_idle_task(void);
+
+/**
+ * Earliest time at which any subsystem has work to do.
+ */
+uint32_t tickless_idle_next_deadline(void);
+
+/**
+ * Platform implementation -- sleeps for up to the given number of milliseconds, returning early if
+ * tickless_idle_wake() is invoked.
+ */
+void tickless_idle_sleep(uint32_t ms);
+
+/**
+ * Platform implementation -- ends the current sleep, or prevents the next one. Safe to call from
+ * interrupt handlers.
+ */
+void tickless_idle_wake(void);
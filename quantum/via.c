@@ -57,6 +57,23 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(TASK_PROFILER_ENABLE)
+#    include "task_profiler.h"
+#endif
+
+#if defined(LATENCY_TRACE_ENABLE)
+#    include "latency_trace.h"
+#endif
+
+#if defined(SPLIT_TELEMETRY_ENABLE)
+#    include "split_telemetry.h"
+#    include "transactions.h"
+#endif
+
+#if defined(TASK_PROFILER_ENABLE) || defined(LATENCY_TRACE_ENABLE) || defined(SPLIT_TELEMETRY_ENABLE)
+#    include "util.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -447,6 +464,97 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#ifdef TASK_PROFILER_ENABLE
+        case id_task_profiler_get_stats: {
+            // data = [ command_id, stage, stage_count, count(4), min(4), max(4), p50(4), p99(4) ]
+            task_profiler_stats_t stats;
+            if (!task_profiler_get_stats(command_data[0], &stats)) {
+                *command_id = id_unhandled;
+                break;
+            }
+            command_data[1]         = TASK_PROFILER_STAGE_COUNT;
+            const uint32_t values[] = {stats.count, stats.min, stats.max, stats.p50, stats.p99};
+            for (uint8_t i = 0; i < ARRAY_SIZE(values); i++) {
+                command_data[2 + i * 4 + 0] = (values[i] >> 24) & 0xFF;
+                command_data[2 + i * 4 + 1] = (values[i] >> 16) & 0xFF;
+                command_data[2 + i * 4 + 2] = (values[i] >> 8) & 0xFF;
+                command_data[2 + i * 4 + 3] = values[i] & 0xFF;
+            }
+            break;
+        }
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+        case id_latency_trace_get_stats: {
+            // data = [ command_id, stage, stage_count, count(4), min(4), avg(4), max(4), dropped(4) ]
+            if (command_data[0] == 0xFF) {
+                latency_trace_reset();
+                break;
+            }
+            latency_trace_stats_t stats;
+            if (!latency_trace_get_stats(command_data[0], &stats)) {
+                *command_id = id_unhandled;
+                break;
+            }
+            command_data[1]         = LATENCY_TRACE_STAGE_COUNT;
+            const uint32_t values[] = {stats.count, stats.min_us, stats.avg_us, stats.max_us, latency_trace_dropped_count()};
+            for (uint8_t i = 0; i < ARRAY_SIZE(values); i++) {
+                command_data[2 + i * 4 + 0] = (values[i] >> 24) & 0xFF;
+                command_data[2 + i * 4 + 1] = (values[i] >> 16) & 0xFF;
+                command_data[2 + i * 4 + 2] = (values[i] >> 8) & 0xFF;
+                command_data[2 + i * 4 + 3] = values[i] & 0xFF;
+            }
+            break;
+        }
+#endif
+#ifdef SPLIT_TELEMETRY_ENABLE
+        case id_split_telemetry_get_stats: {
+            // data = [ command_id, half, transaction_id, transaction_count, attempts(4), retries(4), failures(4), bytes(4), min(2), avg(2), max(2), corrupted(4), invalid(2) ]
+            // or [ command_id, 0xFF, action ] with action 0 = reset, 1 = stress off, 2 = stress on
+            if (command_data[0] == 0xFF) {
+                switch (command_data[1]) {
+                    case 0:
+                        split_telemetry_reset();
+                        break;
+                    case 1:
+                    case 2:
+                        split_telemetry_stress(command_data[1] == 2);
+                        break;
+                    default:
+                        *command_id = id_unhandled;
+                        break;
+                }
+                break;
+            }
+            split_telemetry_stats_t    stats;
+            split_telemetry_counters_t counters;
+            if (command_data[0] > SPLIT_TELEMETRY_SLAVE || !split_telemetry_get_stats(command_data[0], command_data[1], &stats) || !split_telemetry_get_counters(command_data[0], &counters)) {
+                *command_id = id_unhandled;
+                break;
+            }
+            command_data[2]         = NUM_TOTAL_TRANSACTIONS;
+            const uint32_t values[] = {stats.attempts, stats.retries, stats.failures, stats.bytes};
+            for (uint8_t i = 0; i < ARRAY_SIZE(values); i++) {
+                command_data[3 + i * 4 + 0] = (values[i] >> 24) & 0xFF;
+                command_data[3 + i * 4 + 1] = (values[i] >> 16) & 0xFF;
+                command_data[3 + i * 4 + 2] = (values[i] >> 8) & 0xFF;
+                command_data[3 + i * 4 + 3] = values[i] & 0xFF;
+            }
+            // Durations and the invalid count are saturated to 16 bits, so that everything fits in one report
+            const uint16_t durations[] = {MIN(stats.min_us, UINT16_MAX), MIN(stats.avg_us, UINT16_MAX), MIN(stats.max_us, UINT16_MAX)};
+            for (uint8_t i = 0; i < ARRAY_SIZE(durations); i++) {
+                command_data[19 + i * 2 + 0] = (durations[i] >> 8) & 0xFF;
+                command_data[19 + i * 2 + 1] = durations[i] & 0xFF;
+            }
+            const uint16_t invalid = MIN(counters.invalid, UINT16_MAX);
+            command_data[25]       = (counters.corrupted >> 24) & 0xFF;
+            command_data[26]       = (counters.corrupted >> 16) & 0xFF;
+            command_data[27]       = (counters.corrupted >> 8) & 0xFF;
+            command_data[28]       = counters.corrupted & 0xFF;
+            command_data[29]       = (invalid >> 8) & 0xFF;
+            command_data[30]       = invalid & 0xFF;
+            break;
+        }
 #endif
         default: {
             // The command ID is not known
@@ -93,6 +93,9 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_task_profiler_get_stats              = 0x16,
+    id_latency_trace_get_stats              = 0x17,
+    id_split_telemetry_get_stats            = 0x18,
     id_unhandled                            = 0xFF,
 };
 
@@ -0,0 +1,52 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "benchmark.hpp"
+
+#define BENCH_LAYER_COUNT 8
+
+// Keycodes are looked up through the test fixture's keymap, so compare against the lookup baseline
+class ActionLayerBench : public TestFixture {
+   public:
+    void SetUp() override {
+        for (uint8_t layer = 0; layer < BENCH_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    add_key(KeymapKey(layer, col, row, layer == 0 ? KC_A + row * MATRIX_COLS + col : KC_TRANSPARENT));
+                }
+            }
+        }
+    }
+
+    void TearDown() override {
+        layer_clear();
+    }
+
+    keypos_t next_key() {
+        keypos_t key = {.col = (uint8_t)(keys % MATRIX_COLS), .row = (uint8_t)((keys / MATRIX_COLS) % MATRIX_ROWS)};
+        keys++;
+        return key;
+    }
+
+    uint32_t keys = 0;
+};
+
+TEST_F(ActionLayerBench, KeycodeLookupBaseline) {
+    run_benchmark("keymap_key_to_keycode", [&] { do_not_optimize(keymap_key_to_keycode(0, next_key())); });
+}
+
+TEST_F(ActionLayerBench, BaseLayer) {
+    run_benchmark("layer_switch_get_action/base_layer", [&] { do_not_optimize(layer_switch_get_action(next_key())); });
+}
+
+TEST_F(ActionLayerBench, TransparentLayers) {
+    // Every active layer above the base layer is transparent, the worst case
+    layer_state_set(((layer_state_t)1 << BENCH_LAYER_COUNT) - 1);
+    run_benchmark("layer_switch_get_action/8_transparent_layers", [&] { do_not_optimize(layer_switch_get_action(next_key())); });
+}
+
+TEST_F(ActionLayerBench, SparseLayers) {
+    layer_state_set((layer_state_t)1 << (BENCH_LAYER_COUNT - 1));
+    run_benchmark("layer_switch_get_action/1_transparent_layer", [&] { do_not_optimize(layer_switch_get_action(next_key())); });
+}
@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SRC += \
+	tests/test_common/benchmark.cpp \
+	tests/bench/action_layer/bench_action_layer.cpp
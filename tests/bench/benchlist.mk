@@ -0,0 +1,11 @@
+BENCH_LIST += \
+	bench_color \
+	bench_debounce_none \
+	bench_debounce_sym_defer_g \
+	bench_debounce_sym_defer_pk \
+	bench_debounce_sym_defer_pr \
+	bench_debounce_sym_eager_pk \
+	bench_debounce_sym_eager_pr \
+	bench_debounce_asym_eager_defer_pk \
+	bench_deferred_exec \
+	bench_wear_leveling
@@ -0,0 +1,56 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "benchmark.hpp"
+
+extern "C" {
+#include "color.h"
+}
+
+#define BENCH_COLOR_COUNT 128
+
+// Converts a frame's worth of colors spread over the whole hue circle, as a rainbow effect would
+class ColorBench : public testing::Test {
+   protected:
+    void SetUp() override {
+        for (uint16_t i = 0; i < BENCH_COLOR_COUNT; i++) {
+            hsv[i] = (HSV){(uint8_t)(i * 2), (uint8_t)(255 - i), (uint8_t)(128 + i)};
+        }
+    }
+
+    HSV hsv[BENCH_COLOR_COUNT];
+    RGB rgb[BENCH_COLOR_COUNT];
+};
+
+TEST_F(ColorBench, HsvToRgb) {
+    run_benchmark("color/hsv_to_rgb", [&] {
+        for (uint16_t i = 0; i < BENCH_COLOR_COUNT; i++) {
+            rgb[i] = hsv_to_rgb(hsv[i]);
+        }
+        do_not_optimize(rgb);
+    });
+}
+
+TEST_F(ColorBench, HsvToRgbBatch) {
+    run_benchmark("color/hsv_to_rgb_batch", [&] {
+        hsv_to_rgb_batch(hsv, rgb, BENCH_COLOR_COUNT);
+        do_not_optimize(rgb);
+    });
+}
+
+TEST_F(ColorBench, HsvToRgbNocie) {
+    run_benchmark("color/hsv_to_rgb_nocie", [&] {
+        for (uint16_t i = 0; i < BENCH_COLOR_COUNT; i++) {
+            rgb[i] = hsv_to_rgb_nocie(hsv[i]);
+        }
+        do_not_optimize(rgb);
+    });
+}
+
+TEST_F(ColorBench, HsvToRgbNocieBatch) {
+    run_benchmark("color/hsv_to_rgb_nocie_batch", [&] {
+        hsv_to_rgb_nocie_batch(hsv, rgb, BENCH_COLOR_COUNT);
+        do_not_optimize(rgb);
+    });
+}
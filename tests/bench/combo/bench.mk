@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = bench_combos.c
+
+SRC += \
+	tests/test_common/benchmark.cpp \
+	tests/simulator/simulator_keymap.c
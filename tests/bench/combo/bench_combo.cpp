@@ -0,0 +1,59 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "benchmark.hpp"
+
+using testing::NiceMock;
+
+// The 4x10 layout shared with the tests in tests/simulator
+extern "C" const uint16_t simulator_keymap[MATRIX_ROWS][MATRIX_COLS];
+
+// Drives process_combo() directly with the 32 combos from bench_combos.c
+class ComboBench : public TestFixture {
+   public:
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, simulator_keymap[row][col]));
+            }
+        }
+    }
+
+    bool process(uint8_t row, uint8_t col, bool pressed) {
+        keyrecord_t record   = {};
+        record.event.key.row = row;
+        record.event.key.col = col;
+        record.event.pressed = pressed;
+        record.event.time    = timer_read();
+        record.event.type    = KEY_EVENT;
+        return process_combo(simulator_keymap[row][col], &record);
+    }
+};
+
+TEST_F(ComboBench, UnrelatedKey) {
+    NiceMock<TestDriver> driver;
+    run_benchmark("process_combo/unrelated_key", [&] {
+        do_not_optimize(process(3, 4, true));
+        do_not_optimize(process(3, 4, false));
+    });
+}
+
+TEST_F(ComboBench, ComboKeyTap) {
+    // A combo key on its own is buffered, then replayed once it is released
+    NiceMock<TestDriver> driver;
+    run_benchmark("process_combo/combo_key_tap", [&] {
+        do_not_optimize(process(1, 6, true));
+        do_not_optimize(process(1, 6, false));
+    });
+}
+
+TEST_F(ComboBench, Chord) {
+    NiceMock<TestDriver> driver;
+    run_benchmark("process_combo/chord", [&] {
+        do_not_optimize(process(1, 6, true));
+        do_not_optimize(process(1, 7, true));
+        do_not_optimize(process(1, 6, false));
+        do_not_optimize(process(1, 7, false));
+    });
+}
@@ -0,0 +1,75 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Every horizontally adjacent pair of alpha keys, plus a few vertical pairs
+uint16_t const combo_00[] = {KC_Q, KC_W, COMBO_END};
+uint16_t const combo_01[] = {KC_W, KC_E, COMBO_END};
+uint16_t const combo_02[] = {KC_E, KC_R, COMBO_END};
+uint16_t const combo_03[] = {KC_R, KC_T, COMBO_END};
+uint16_t const combo_04[] = {KC_T, KC_Y, COMBO_END};
+uint16_t const combo_05[] = {KC_Y, KC_U, COMBO_END};
+uint16_t const combo_06[] = {KC_U, KC_I, COMBO_END};
+uint16_t const combo_07[] = {KC_I, KC_O, COMBO_END};
+uint16_t const combo_08[] = {KC_O, KC_P, COMBO_END};
+uint16_t const combo_09[] = {KC_A, KC_S, COMBO_END};
+uint16_t const combo_10[] = {KC_S, KC_D, COMBO_END};
+uint16_t const combo_11[] = {KC_D, KC_F, COMBO_END};
+uint16_t const combo_12[] = {KC_F, KC_G, COMBO_END};
+uint16_t const combo_13[] = {KC_G, KC_H, COMBO_END};
+uint16_t const combo_14[] = {KC_H, KC_J, COMBO_END};
+uint16_t const combo_15[] = {KC_J, KC_K, COMBO_END};
+uint16_t const combo_16[] = {KC_K, KC_L, COMBO_END};
+uint16_t const combo_17[] = {KC_L, KC_SCLN, COMBO_END};
+uint16_t const combo_18[] = {KC_Z, KC_X, COMBO_END};
+uint16_t const combo_19[] = {KC_X, KC_C, COMBO_END};
+uint16_t const combo_20[] = {KC_C, KC_V, COMBO_END};
+uint16_t const combo_21[] = {KC_V, KC_B, COMBO_END};
+uint16_t const combo_22[] = {KC_B, KC_N, COMBO_END};
+uint16_t const combo_23[] = {KC_N, KC_M, COMBO_END};
+uint16_t const combo_24[] = {KC_M, KC_COMM, COMBO_END};
+uint16_t const combo_25[] = {KC_COMM, KC_DOT, COMBO_END};
+uint16_t const combo_26[] = {KC_DOT, KC_SLSH, COMBO_END};
+uint16_t const combo_27[] = {KC_Q, KC_A, COMBO_END};
+uint16_t const combo_28[] = {KC_W, KC_S, COMBO_END};
+uint16_t const combo_29[] = {KC_E, KC_D, COMBO_END};
+uint16_t const combo_30[] = {KC_R, KC_F, COMBO_END};
+uint16_t const combo_31[] = {KC_T, KC_G, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    COMBO(combo_00, KC_F1),
+    COMBO(combo_01, KC_F2),
+    COMBO(combo_02, KC_F3),
+    COMBO(combo_03, KC_F4),
+    COMBO(combo_04, KC_F5),
+    COMBO(combo_05, KC_F6),
+    COMBO(combo_06, KC_F7),
+    COMBO(combo_07, KC_F8),
+    COMBO(combo_08, KC_F9),
+    COMBO(combo_09, KC_F10),
+    COMBO(combo_10, KC_F11),
+    COMBO(combo_11, KC_F12),
+    COMBO(combo_12, KC_F13),
+    COMBO(combo_13, KC_F14),
+    COMBO(combo_14, KC_F15),
+    COMBO(combo_15, KC_F16),
+    COMBO(combo_16, KC_F17),
+    COMBO(combo_17, KC_F18),
+    COMBO(combo_18, KC_F19),
+    COMBO(combo_19, KC_F20),
+    COMBO(combo_20, KC_F21),
+    COMBO(combo_21, KC_F22),
+    COMBO(combo_22, KC_F23),
+    COMBO(combo_23, KC_F24),
+    COMBO(combo_24, KC_F1),
+    COMBO(combo_25, KC_F2),
+    COMBO(combo_26, KC_F3),
+    COMBO(combo_27, KC_F4),
+    COMBO(combo_28, KC_F5),
+    COMBO(combo_29, KC_F6),
+    COMBO(combo_30, KC_F7),
+    COMBO(combo_31, KC_F8)
+};
+// clang-format on
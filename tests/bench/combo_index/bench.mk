@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../combo/bench_combos.c
+
+SRC += \
+	tests/test_common/benchmark.cpp \
+	tests/bench/combo/bench_combo.cpp \
+	tests/simulator/simulator_keymap.c
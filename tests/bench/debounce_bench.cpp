@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include "gtest/gtest.h"
+#include "benchmark.hpp"
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+// Each iteration is a single matrix scan at 1kHz, the algorithm being selected at build time
+class DebounceBench : public testing::Test {
+   protected:
+    void SetUp() override {
+        debounce_init(MATRIX_ROWS);
+        std::fill(std::begin(raw), std::end(raw), 0);
+        std::fill(std::begin(cooked), std::end(cooked), 0);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+
+    void scan(bool changed) {
+        do_not_optimize(debounce(raw, cooked, MATRIX_ROWS, changed));
+        advance_time(1);
+    }
+
+    void toggle(uint8_t key) {
+        raw[key / MATRIX_COLS] ^= (matrix_row_t)1 << (key % MATRIX_COLS);
+    }
+
+    matrix_row_t raw[MATRIX_ROWS];
+    matrix_row_t cooked[MATRIX_ROWS];
+};
+
+TEST_F(DebounceBench, Idle) {
+    run_benchmark("debounce/idle", [&] { scan(false); });
+}
+
+TEST_F(DebounceBench, Typing) {
+    // A transition every 8 scans, cycling through the matrix, so every key settles in between
+    uint32_t scans = 0;
+    run_benchmark("debounce/typing", [&] {
+        bool changed = scans % 8 == 0;
+        if (changed) {
+            toggle((scans / 8) % (MATRIX_ROWS * MATRIX_COLS));
+        }
+        scan(changed);
+        scans++;
+    });
+}
+
+TEST_F(DebounceBench, Chatter) {
+    // Every key bouncing on every scan, the worst case for per-key algorithms
+    run_benchmark("debounce/chatter", [&] {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            raw[row] = ~raw[row];
+        }
+        scan(true);
+    });
+}
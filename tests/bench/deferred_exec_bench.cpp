@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "benchmark.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+#define BENCH_EXECUTOR_COUNT 200
+
+static uint32_t idle_callback(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+
+// Fills a table of the size used by a busy set of Quantum Painter animations, none of which are due soon
+class DeferredExecBench : public testing::Test {
+   protected:
+    void SetUp() override {
+        for (uint32_t i = 0; i < BENCH_EXECUTOR_COUNT - 1; i++) {
+            tokens[i] = defer_exec_advanced(table, BENCH_EXECUTOR_COUNT, 1000000 + i * 7919 % 1000, idle_callback, NULL);
+        }
+    }
+
+    deferred_executor_t table[BENCH_EXECUTOR_COUNT] = {};
+    deferred_token      tokens[BENCH_EXECUTOR_COUNT - 1];
+    uint32_t            last_execution_time = 0;
+};
+
+TEST_F(DeferredExecBench, TaskNothingDue) {
+    run_benchmark("deferred_exec_advanced_task/200_pending", [&] {
+        advance_time(1);
+        deferred_exec_advanced_task(table, BENCH_EXECUTOR_COUNT, &last_execution_time);
+    });
+}
+
+TEST_F(DeferredExecBench, DeferAndCancel) {
+    run_benchmark("defer_exec_advanced+cancel/200_pending", [&] {
+        deferred_token token = defer_exec_advanced(table, BENCH_EXECUTOR_COUNT, 500, idle_callback, NULL);
+        do_not_optimize(cancel_deferred_exec_advanced(table, BENCH_EXECUTOR_COUNT, token));
+    });
+}
+
+TEST_F(DeferredExecBench, Extend) {
+    uint32_t extends = 0;
+    run_benchmark("extend_deferred_exec_advanced/200_pending", [&] {
+        do_not_optimize(extend_deferred_exec_advanced(table, BENCH_EXECUTOR_COUNT, tokens[extends % (BENCH_EXECUTOR_COUNT - 1)], 1000000 + extends % 1000));
+        extends++;
+    });
+}
@@ -0,0 +1,666 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "benchmark.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_draw.h"
+#include "qp_surface.h"
+#include "qp_comms_dummy.h"
+#include "color.h"
+
+extern const uint8_t font_thintel15[];
+
+void qp_internal_animation_tick(void);
+void advance_time(uint32_t ms);
+}
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define BENCH_SURFACE_SIZE 64
+#define BENCH_PIXEL_COUNT (BENCH_SURFACE_SIZE * BENCH_SURFACE_SIZE)
+
+static uint8_t surface_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(BENCH_SURFACE_SIZE, BENCH_SURFACE_SIZE, 16)];
+static uint8_t pixel_data[BENCH_PIXEL_COUNT * 2];
+
+// Streams a full-surface frame of the given bpp through qp_internal_appender(), as qp_drawimage() does
+class PainterBench : public ::testing::Test {
+   protected:
+    // Surfaces come from a fixed-size pool, so the device is shared by all benchmarks
+    static painter_device_t device;
+
+    static void SetUpTestSuite() {
+        device = qp_make_rgb565_surface(BENCH_SURFACE_SIZE, BENCH_SURFACE_SIZE, surface_buffer);
+        for (size_t i = 0; i < sizeof(pixel_data); ++i) {
+            pixel_data[i] = (uint8_t)(i * 37 + 11);
+        }
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+    }
+
+    void bench_appender(const char *name, uint8_t bpp) {
+        painter_driver_t *driver = (painter_driver_t *)device;
+
+        if (bpp <= 8) {
+            qp_internal_invalidate_palette();
+            qp_internal_interpolate_palette((qp_pixel_t){.hsv888 = {0, 0, 255}}, (qp_pixel_t){.hsv888 = {0, 0, 0}}, 1 << bpp);
+            ASSERT_TRUE(driver->driver_vtable->palette_convert(device, 1 << bpp, qp_internal_global_pixel_lookup_table));
+        }
+
+        uint32_t byte_count = (BENCH_PIXEL_COUNT * bpp + 7) / 8;
+        run_benchmark(name, [&] {
+            qp_memory_stream_t             stream      = qp_make_memory_stream(pixel_data, byte_count);
+            qp_internal_byte_input_state_t input_state = {.device = device, .src_stream = (qp_stream_t *)&stream};
+            qp_internal_byte_input_callback input_cb   = qp_internal_prepare_input_state(&input_state, IMAGE_UNCOMPRESSED);
+            driver->driver_vtable->viewport(device, 0, 0, BENCH_SURFACE_SIZE - 1, BENCH_SURFACE_SIZE - 1);
+            do_not_optimize(qp_internal_appender(device, bpp, BENCH_PIXEL_COUNT, input_cb, &input_state));
+        });
+    }
+};
+
+painter_device_t PainterBench::device = NULL;
+
+TEST_F(PainterBench, Palette1bpp) {
+    bench_appender("qp_internal_appender/1bpp", 1);
+}
+
+TEST_F(PainterBench, Palette2bpp) {
+    bench_appender("qp_internal_appender/2bpp", 2);
+}
+
+TEST_F(PainterBench, Palette4bpp) {
+    bench_appender("qp_internal_appender/4bpp", 4);
+}
+
+TEST_F(PainterBench, Palette8bpp) {
+    bench_appender("qp_internal_appender/8bpp", 8);
+}
+
+TEST_F(PainterBench, Native16bpp) {
+    bench_appender("qp_internal_appender/16bpp", 16);
+}
+
+// QMK RLE, as emitted by compress_bytes_qmk_rle() -- repeated runs of up to 127 bytes, non-repeated runs of up to 128
+static std::vector<uint8_t> encode_rle(const uint8_t *data, size_t length) {
+    std::vector<uint8_t> out;
+    size_t               n = 0;
+    while (n < length) {
+        size_t run = 1;
+        while (n + run < length && data[n + run] == data[n] && run < 127) {
+            ++run;
+        }
+        if (run >= 2) {
+            out.push_back(run);
+            out.push_back(data[n]);
+            n += run;
+            continue;
+        }
+        size_t start = n;
+        while (n < length && n - start < 128 && (n + 1 >= length || data[n + 1] != data[n])) {
+            ++n;
+        }
+        out.push_back(127 + (n - start));
+        out.insert(out.end(), &data[start], &data[n]);
+    }
+    return out;
+}
+
+// QMK block RLE, as emitted by compress_bytes_qmk_block_rle()
+static std::vector<uint8_t> encode_block_rle(const uint8_t *data, size_t length) {
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> literal;
+    auto                 append_marker = [&](uint8_t flags, size_t run) {
+        run -= 1;
+        if (run < 0x40) {
+            out.push_back(flags | run);
+        } else {
+            out.push_back(flags | 0x40 | (run >> 8));
+            out.push_back(run & 0xFF);
+        }
+    };
+    auto append_literal = [&] {
+        if (!literal.empty()) {
+            append_marker(0x80, literal.size());
+            out.insert(out.end(), literal.begin(), literal.end());
+            literal.clear();
+        }
+    };
+    size_t n = 0;
+    while (n < length) {
+        size_t run = 1;
+        while (n + run < length && data[n + run] == data[n] && run < 16384) {
+            ++run;
+        }
+        if (run >= 3) {
+            append_literal();
+            append_marker(0x00, run);
+            out.push_back(data[n]);
+        } else {
+            literal.insert(literal.end(), &data[n], &data[n + run]);
+        }
+        n += run;
+        if (literal.size() == 16384) {
+            append_literal();
+        }
+    }
+    append_literal();
+    return out;
+}
+
+// Decodes the same UI-like frame (flat areas broken up by detail) stored with each compression scheme, checking that the
+// surface ends up identical
+TEST_F(PainterBench, Compression) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    uint8_t           image[BENCH_PIXEL_COUNT];
+    for (size_t i = 0; i < sizeof(image); ++i) {
+        size_t row = i / BENCH_SURFACE_SIZE, col = i % BENCH_SURFACE_SIZE;
+        image[i]   = (row % 16 < 4) ? (uint8_t)(row * 13 + col * 7) : (col < 40 ? 0x11 : 0x5A);
+    }
+
+    for (uint8_t bpp : {1, 2, 4, 8}) {
+        qp_internal_invalidate_palette();
+        qp_internal_interpolate_palette((qp_pixel_t){.hsv888 = {0, 0, 255}}, (qp_pixel_t){.hsv888 = {0, 0, 0}}, 1 << bpp);
+        ASSERT_TRUE(driver->driver_vtable->palette_convert(device, 1 << bpp, qp_internal_global_pixel_lookup_table));
+
+        uint32_t byte_count = (BENCH_PIXEL_COUNT * bpp + 7) / 8;
+        struct {
+            const char *          name;
+            painter_compression_t compression;
+            std::vector<uint8_t>  data;
+        } schemes[] = {
+            {"uncompressed", IMAGE_UNCOMPRESSED, std::vector<uint8_t>(image, image + byte_count)},
+            {"rle", IMAGE_COMPRESSED_RLE, encode_rle(image, byte_count)},
+            {"block-rle", IMAGE_COMPRESSED_BLOCK_RLE, encode_block_rle(image, byte_count)},
+        };
+
+        std::vector<uint8_t> expected;
+        for (auto &scheme : schemes) {
+            auto draw = [&] {
+                qp_memory_stream_t              stream      = qp_make_memory_stream(scheme.data.data(), scheme.data.size());
+                qp_internal_byte_input_state_t  input_state = {.device = device, .src_stream = (qp_stream_t *)&stream};
+                qp_internal_byte_input_callback input_cb    = qp_internal_prepare_input_state(&input_state, scheme.compression);
+                driver->driver_vtable->viewport(device, 0, 0, BENCH_SURFACE_SIZE - 1, BENCH_SURFACE_SIZE - 1);
+                return qp_internal_appender(device, bpp, BENCH_PIXEL_COUNT, input_cb, &input_state);
+            };
+
+            ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+            ASSERT_TRUE(draw());
+            std::vector<uint8_t> actual(surface_buffer, surface_buffer + sizeof(surface_buffer));
+            if (expected.empty()) {
+                expected = actual;
+            }
+            EXPECT_EQ(expected, actual) << scheme.name << " at " << (int)bpp << "bpp";
+
+            std::string name = "qp_internal_appender/" + std::to_string(bpp) + "bpp/" + scheme.name + " (" + std::to_string(scheme.data.size()) + " bytes)";
+            run_benchmark(name.c_str(), [&] { do_not_optimize(draw()); });
+        }
+    }
+}
+
+TEST_F(PainterBench, FillPixdata) {
+    uint32_t pixel_count = qp_internal_num_pixels_in_buffer(device);
+    run_benchmark("qp_internal_fill_pixdata/16bpp", [&] { qp_internal_fill_pixdata(device, pixel_count, 85, 255, 255); });
+}
+
+struct BenchQgfFrame {
+    bool                 delta;
+    uint16_t             left, top, right, bottom;
+    std::vector<uint8_t> pixels;
+};
+
+// Builds an uncompressed 8bpp palette QGF, with the same palette on each frame
+static std::vector<uint8_t> make_bench_qgf(uint16_t width, uint16_t height, const std::vector<BenchQgfFrame> &frames, const std::vector<uint8_t> &palette) {
+    std::vector<uint8_t> out;
+    auto                 append = [&](uint32_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) {
+            out.push_back(value >> (i * 8));
+        }
+    };
+    auto append_header = [&](uint8_t type_id, uint32_t length) {
+        out.push_back(type_id);
+        out.push_back(~type_id);
+        append(length, 3);
+    };
+
+    append_header(0x00, 18);
+    append(0x464751, 3);
+    append(1, 1);
+    append(0, 8); // file size, filled in below
+    append(width, 2);
+    append(height, 2);
+    append(frames.size(), 2);
+
+    append_header(0x01, frames.size() * 4);
+    size_t offsets = out.size();
+    append(0, frames.size() * 4);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const BenchQgfFrame &frame = frames[i];
+        uint32_t             pos   = out.size();
+        memcpy(&out[offsets + i * 4], &pos, 4);
+
+        append_header(0x02, 6);
+        append(PALETTE_8BPP, 1);
+        append(frame.delta ? 0x02 : 0x00, 1);
+        append(IMAGE_UNCOMPRESSED, 1);
+        append(0, 1);
+        append(33, 2);
+
+        append_header(0x03, palette.size());
+        out.insert(out.end(), palette.begin(), palette.end());
+
+        if (frame.delta) {
+            append_header(0x04, 8);
+            append(frame.left, 2);
+            append(frame.top, 2);
+            append(frame.right, 2);
+            append(frame.bottom, 2);
+        }
+
+        append_header(0x05, frame.pixels.size());
+        out.insert(out.end(), frame.pixels.begin(), frame.pixels.end());
+    }
+
+    uint32_t size = out.size(), neg_size = ~size;
+    memcpy(&out[9], &size, 4);
+    memcpy(&out[13], &neg_size, 4);
+    return out;
+}
+
+// Plays back an animation of a square moving over a static background, where all frames after the first are deltas
+// covering just the square's old and new positions. After each frame the surface is compared with the equivalent full
+// frame, drawn from an image using the same colors but with a different palette order.
+TEST_F(PainterBench, AnimationDeltas) {
+    const uint16_t       size = BENCH_SURFACE_SIZE, square = 8, num_frames = 8;
+    std::vector<uint8_t> palette, reordered_palette;
+    for (int i = 0; i < 256; ++i) {
+        palette.insert(palette.end(), {(uint8_t)i, 255, (uint8_t)(255 - i / 2)});
+    }
+    for (int i = 0; i < 256; ++i) {
+        reordered_palette.insert(reordered_palette.end(), &palette[(255 - i) * 3], &palette[(255 - i) * 3 + 3]);
+    }
+
+    auto render = [&](uint16_t frame, uint16_t l, uint16_t t, uint16_t r, uint16_t b, bool reorder) {
+        std::vector<uint8_t> pixels;
+        for (uint16_t y = t; y <= b; ++y) {
+            for (uint16_t x = l; x <= r; ++x) {
+                uint16_t sx = frame * 6, sy = frame * 3;
+                uint8_t  index = (x >= sx && x < sx + square && y >= sy && y < sy + square) ? 250 : (uint8_t)((x / 4 + y / 4) * 9);
+                pixels.push_back(reorder ? 255 - index : index);
+            }
+        }
+        return pixels;
+    };
+
+    std::vector<BenchQgfFrame> delta_frames, full_frames;
+    for (uint16_t f = 0; f < num_frames; ++f) {
+        full_frames.push_back({false, 0, 0, 0, 0, render(f, 0, 0, size - 1, size - 1, true)});
+        if (f == 0) {
+            delta_frames.push_back({false, 0, 0, 0, 0, render(f, 0, 0, size - 1, size - 1, false)});
+        } else {
+            uint16_t l = (f - 1) * 6, t = (f - 1) * 3, r = f * 6 + square - 1, b = f * 3 + square - 1;
+            delta_frames.push_back({true, l, t, r, b, render(f, l, t, r, b, false)});
+        }
+    }
+    // Loop back around to the first frame
+    delta_frames.push_back({true, 0, 0, (uint16_t)(num_frames * 6 + square - 1), (uint16_t)(num_frames * 3 + square - 1), render(0, 0, 0, num_frames * 6 + square - 1, num_frames * 3 + square - 1, false)});
+
+    std::vector<uint8_t>   delta_qgf = make_bench_qgf(size, size, delta_frames, palette);
+    painter_image_handle_t anim      = qp_load_image_mem(delta_qgf.data());
+    ASSERT_NE(anim, nullptr);
+
+    // Each frame of the reference image is loaded as a separate single-frame image
+    std::vector<std::vector<uint8_t>> reference_qgfs;
+    for (auto &frame : full_frames) {
+        reference_qgfs.push_back(make_bench_qgf(size, size, {frame}, reordered_palette));
+    }
+
+    deferred_token token = qp_animate(device, 0, 0, anim);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    for (uint16_t f = 0; f <= num_frames; ++f) {
+        if (f > 0) {
+            advance_time(33);
+            qp_internal_animation_tick();
+        }
+        std::vector<uint8_t> actual(surface_buffer, surface_buffer + sizeof(surface_buffer));
+
+        painter_image_handle_t reference = qp_load_image_mem(reference_qgfs[f % num_frames].data());
+        ASSERT_NE(reference, nullptr);
+        ASSERT_TRUE(qp_drawimage(device, 0, 0, reference));
+        qp_close_image(reference);
+        std::vector<uint8_t> expected(surface_buffer, surface_buffer + sizeof(surface_buffer));
+        EXPECT_EQ(expected, actual) << "frame " << f;
+    }
+
+    run_benchmark("qp_animate/delta-frame", [&] {
+        advance_time(33);
+        qp_internal_animation_tick();
+    });
+
+    qp_stop_animation(token);
+    qp_close_image(anim);
+}
+
+#define BENCH_PANEL_SIZE 128
+#define BENCH_WIDGET_SIZE 8
+
+static uint8_t panel_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, 16)];
+static uint8_t rgb565_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, 16)];
+static uint8_t palette8bpp_buffer[SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, 8)];
+static uint8_t palette4bpp_buffer[SURFACE_PALETTE_REQUIRED_BUFFER_BYTE_SIZE(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, 4)];
+
+// Redraws two small widgets in opposite corners of a surface backing a panel, and flushes it
+class PainterSurfaceBench : public ::testing::Test {
+   protected:
+    static painter_device_t panel;
+    static painter_device_t rgb565_surface;
+    static painter_device_t palette8bpp_surface;
+    static painter_device_t palette4bpp_surface;
+
+    static void SetUpTestSuite() {
+        panel               = qp_make_rgb565_surface(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, panel_buffer);
+        rgb565_surface      = qp_make_rgb565_surface(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, rgb565_buffer);
+        palette8bpp_surface = qp_make_palette8bpp_surface(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, palette8bpp_buffer);
+        palette4bpp_surface = qp_make_palette4bpp_surface(BENCH_PANEL_SIZE, BENCH_PANEL_SIZE, palette4bpp_buffer);
+    }
+
+    void bench_widgets(const char *name, painter_device_t surface) {
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        ASSERT_TRUE(qp_surface_attach(surface, panel, 0, 0));
+        ASSERT_TRUE(qp_flush(surface));
+
+        uint8_t hue    = 0;
+        auto    redraw = [&] {
+            hue += 64;
+            qp_rect(surface, 0, 0, BENCH_WIDGET_SIZE - 1, BENCH_WIDGET_SIZE - 1, hue, 255, 255, true);
+            qp_rect(surface, BENCH_PANEL_SIZE - BENCH_WIDGET_SIZE, BENCH_PANEL_SIZE - BENCH_WIDGET_SIZE, BENCH_PANEL_SIZE - 1, BENCH_PANEL_SIZE - 1, hue, 255, 255, true);
+            return qp_flush(surface);
+        };
+
+        // Both widgets need to have made it to the panel, and nothing else
+        ASSERT_TRUE(redraw());
+        const uint16_t *pixels = (const uint16_t *)panel_buffer;
+        EXPECT_NE(pixels[0], 0);
+        EXPECT_NE(pixels[BENCH_PANEL_SIZE * BENCH_PANEL_SIZE - 1], 0);
+        EXPECT_EQ(pixels[BENCH_PANEL_SIZE * BENCH_PANEL_SIZE / 2], 0);
+        EXPECT_EQ(pixels[0], pixels[BENCH_PANEL_SIZE * BENCH_PANEL_SIZE - 1]);
+
+        run_benchmark(name, [&] { do_not_optimize(redraw()); });
+        ASSERT_TRUE(qp_surface_attach(surface, NULL, 0, 0));
+    }
+};
+
+painter_device_t PainterSurfaceBench::panel               = NULL;
+painter_device_t PainterSurfaceBench::rgb565_surface      = NULL;
+painter_device_t PainterSurfaceBench::palette8bpp_surface = NULL;
+painter_device_t PainterSurfaceBench::palette4bpp_surface = NULL;
+
+TEST_F(PainterSurfaceBench, WidgetsRgb565) {
+    bench_widgets("qp_surface_flush/widgets/rgb565", rgb565_surface);
+}
+
+TEST_F(PainterSurfaceBench, WidgetsPalette8bpp) {
+    bench_widgets("qp_surface_flush/widgets/palette8bpp", palette8bpp_surface);
+}
+
+TEST_F(PainterSurfaceBench, WidgetsPalette4bpp) {
+    bench_widgets("qp_surface_flush/widgets/palette4bpp", palette4bpp_surface);
+}
+
+// Clearing a palette surface resets its palette, so redrawing the same image afterwards needs to add its colors again
+// rather than reusing the palette converted before the clear
+TEST_F(PainterSurfaceBench, PaletteClearRedraw) {
+    std::vector<uint8_t> palette, pixels;
+    for (int i = 0; i < 256; ++i) {
+        palette.insert(palette.end(), {(uint8_t)i, 255, 255});
+    }
+    for (int i = 0; i < BENCH_WIDGET_SIZE * BENCH_WIDGET_SIZE; ++i) {
+        pixels.push_back((uint8_t)((i / BENCH_WIDGET_SIZE) * 29 + 3));
+    }
+    std::vector<uint8_t>   qgf   = make_bench_qgf(BENCH_WIDGET_SIZE, BENCH_WIDGET_SIZE, {{false, 0, 0, 0, 0, pixels}}, palette);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+
+    for (painter_device_t surface : {palette8bpp_surface, palette4bpp_surface}) {
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        ASSERT_TRUE(qp_surface_attach(surface, panel, 0, 0));
+        ASSERT_TRUE(qp_drawimage(surface, 0, 0, image));
+        ASSERT_TRUE(qp_flush(surface));
+        std::vector<uint8_t> expected(panel_buffer, panel_buffer + sizeof(panel_buffer));
+
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+        ASSERT_TRUE(qp_drawimage(surface, 0, 0, image));
+        ASSERT_TRUE(qp_clear(surface));
+        ASSERT_TRUE(qp_drawimage(surface, 0, 0, image));
+        ASSERT_TRUE(qp_flush(surface));
+        std::vector<uint8_t> actual(panel_buffer, panel_buffer + sizeof(panel_buffer));
+        EXPECT_EQ(expected, actual);
+
+        ASSERT_TRUE(qp_surface_attach(surface, NULL, 0, 0));
+    }
+    qp_close_image(image);
+}
+
+// Minimal RGB565 display, counting the transactions that would be sent over the bus
+static uint32_t bus_transactions = 0;
+static uint32_t bus_checksum     = 0;
+
+static bool bus_noop(painter_device_t device) {
+    return true;
+}
+
+static bool bus_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+static bool bus_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+static bool bus_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    ++bus_transactions;
+    return true;
+}
+
+static bool bus_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    ++bus_transactions;
+    const uint16_t *pixels = (const uint16_t *)pixel_data;
+    for (uint32_t i = 0; i < native_pixel_count; ++i) {
+        bus_checksum += pixels[i];
+    }
+    return true;
+}
+
+static bool bus_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB rgb           = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        palette[i].rgb565 = (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+    }
+    return true;
+}
+
+static bool bus_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    uint16_t *buf = (uint16_t *)target_buffer;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = palette[palette_indices[i]].rgb565;
+    }
+    return true;
+}
+
+static bool bus_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+static const painter_driver_vtable_t bus_vtable = {
+    .init            = bus_init,
+    .power           = bus_power,
+    .clear           = bus_noop,
+    .flush           = bus_noop,
+    .viewport        = bus_viewport,
+    .pixdata         = bus_pixdata,
+    .palette_convert = bus_palette_convert,
+    .append_pixels   = bus_append_pixels,
+    .append_pixdata  = bus_append_pixdata,
+};
+
+// Redraws a short status line, as a clock or WPM counter would
+TEST_F(PainterSurfaceBench, DrawText) {
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+    ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+
+    const char *text  = "12:34 WPM 108 Layer: Nav";
+    int16_t     width = qp_textwidth(font, text);
+    ASSERT_GT(width, 0);
+    ASSERT_EQ(qp_drawtext_recolor(panel, 0, 0, font, text, 85, 255, 255, 0, 0, 0), width);
+
+    // The result needs to be identical with or without the glyph cache
+    uint32_t        checksum = 0;
+    const uint16_t *pixels   = (const uint16_t *)panel_buffer;
+    for (uint32_t i = 0; i < BENCH_PANEL_SIZE * BENCH_PANEL_SIZE; ++i) {
+        checksum = checksum * 31 + pixels[i];
+    }
+    EXPECT_EQ(checksum, 2557295542u);
+
+    painter_driver_t display      = {};
+    display.driver_vtable         = &bus_vtable;
+    display.comms_vtable          = &dummy_comms_vtable;
+    display.panel_width           = BENCH_PANEL_SIZE;
+    display.panel_height          = BENCH_PANEL_SIZE;
+    display.native_bits_per_pixel = 16;
+    ASSERT_TRUE(qp_init(&display, QP_ROTATION_0));
+
+    bus_transactions = 0;
+    bus_checksum     = 0;
+    ASSERT_EQ(qp_drawtext_recolor(&display, 0, 0, font, text, 85, 255, 255, 0, 0, 0), width);
+    EXPECT_EQ(bus_checksum, 13190730u);
+    printf("%-40s %u\n", "qp_drawtext_recolor/transactions", (unsigned)bus_transactions);
+
+    run_benchmark("qp_drawtext_recolor", [&] { do_not_optimize(qp_drawtext_recolor(&display, 0, 0, font, text, 85, 255, 255, 0, 0, 0)); });
+    qp_close_font(font);
+}
+
+// Text redrawn after clearing a palette surface can't reuse glyphs decoded using the palette from before the clear
+TEST_F(PainterSurfaceBench, PaletteClearRedrawText) {
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+    const char *text = "12:34 WPM 108";
+
+    auto draw_rect = [&] { return qp_rect(palette8bpp_surface, 0, 32, BENCH_WIDGET_SIZE - 1, 32 + BENCH_WIDGET_SIZE - 1, 170, 255, 255, true); };
+    auto draw_text = [&] { return qp_drawtext_recolor(palette8bpp_surface, 0, 0, font, text, 85, 255, 255, 0, 0, 0) > 0; };
+
+    // The glyphs get cached before the rectangle's color is added to the palette...
+    ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+    ASSERT_TRUE(qp_init(palette8bpp_surface, QP_ROTATION_0));
+    ASSERT_TRUE(qp_surface_attach(palette8bpp_surface, panel, 0, 0));
+    ASSERT_TRUE(draw_text());
+    ASSERT_TRUE(draw_rect());
+    ASSERT_TRUE(qp_flush(palette8bpp_surface));
+    std::vector<uint8_t> expected(panel_buffer, panel_buffer + sizeof(panel_buffer));
+
+    // ...which takes the text's palette entry after the clear
+    ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+    ASSERT_TRUE(qp_clear(palette8bpp_surface));
+    ASSERT_TRUE(draw_rect());
+    ASSERT_TRUE(draw_text());
+    ASSERT_TRUE(qp_flush(palette8bpp_surface));
+    std::vector<uint8_t> actual(panel_buffer, panel_buffer + sizeof(panel_buffer));
+    EXPECT_EQ(expected, actual);
+
+    ASSERT_TRUE(qp_surface_attach(palette8bpp_surface, NULL, 0, 0));
+    qp_close_font(font);
+}
+
+// Builds a 4x4 1bpp font containing only unicode glyphs, optionally with the glyph table out of order
+static std::vector<uint8_t> make_unicode_font(const std::vector<uint32_t> &code_points, bool shuffle) {
+    std::vector<uint8_t> font;
+    auto                 put = [&](uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            font.push_back((value >> (i * 8)) & 0xFF);
+        }
+    };
+    uint32_t total_size = 25 + 5 + code_points.size() * 6 + 5 + code_points.size() * 2;
+
+    // Font descriptor
+    put(0xFF00, 2);
+    put(20, 3);
+    put(0x464651, 3);
+    put(1, 1);
+    put(total_size, 4);
+    put(~total_size, 4);
+    put(4, 1);                  // line height
+    put(0, 1);                  // no ascii table
+    put(code_points.size(), 2); // unicode glyphs
+    put(GRAYSCALE_1BPP, 1);
+    put(0, 1);
+    put(IMAGE_UNCOMPRESSED, 1);
+    put(0xFF, 1);
+
+    // Unicode glyph table, with the data of each glyph stored in code point order
+    std::vector<size_t> order(code_points.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = shuffle ? (i * 7) % order.size() : i;
+    }
+    put(0xFD02, 2);
+    put(code_points.size() * 6, 3);
+    for (size_t i : order) {
+        put(code_points[i], 3);
+        put((i * 2) << 6 | 4, 3);
+    }
+
+    // Glyph data
+    put(0xFA05, 2);
+    put(code_points.size() * 2, 3);
+    for (size_t i = 0; i < code_points.size(); ++i) {
+        put(i * 37 + 5, 1);
+        put(i * 11 + 3, 1);
+    }
+    return font;
+}
+
+// Unicode glyphs are looked up using binary search when in order, and need to render identically to a linear search
+TEST_F(PainterSurfaceBench, UnicodeLookup) {
+    std::vector<uint32_t> code_points;
+    for (uint32_t i = 0; i < 64; ++i) {
+        code_points.push_back(0x2190 + i * 3);
+    }
+    std::vector<uint8_t> sorted_font   = make_unicode_font(code_points, false);
+    std::vector<uint8_t> shuffled_font = make_unicode_font(code_points, true);
+
+    // Every other glyph, in reverse, followed by one that doesn't exist
+    std::string text;
+    for (size_t i = code_points.size(); i > 0; i -= 2) {
+        char     buf[4];
+        uint32_t cp = code_points[i - 1];
+        buf[0]      = 0xE0 | (cp >> 12);
+        buf[1]      = 0x80 | ((cp >> 6) & 0x3F);
+        buf[2]      = 0x80 | (cp & 0x3F);
+        text.append(buf, 3);
+    }
+
+    std::vector<uint16_t> rendered[2];
+    std::vector<uint8_t> *fonts[2] = {&sorted_font, &shuffled_font};
+    for (int f = 0; f < 2; ++f) {
+        painter_font_handle_t font = qp_load_font_mem(fonts[f]->data());
+        ASSERT_NE(font, nullptr);
+        ASSERT_TRUE(qp_init(panel, QP_ROTATION_0));
+        EXPECT_EQ(qp_textwidth(font, text.c_str()), 32 * 4);
+        EXPECT_EQ(qp_drawtext(panel, 0, 0, font, text.c_str()), 32 * 4);
+        EXPECT_EQ(qp_textwidth(font, (text + "\xE2\x86\x91").c_str()), 0);
+        const uint16_t *pixels = (const uint16_t *)panel_buffer;
+        rendered[f].assign(pixels, pixels + BENCH_PANEL_SIZE * 4);
+        qp_close_font(font);
+    }
+    EXPECT_EQ(rendered[0], rendered[1]);
+    EXPECT_NE(std::count(rendered[0].begin(), rendered[0].end(), 0), (ptrdiff_t)rendered[0].size());
+}
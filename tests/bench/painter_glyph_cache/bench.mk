@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = surface
+
+SRC += \
+	tests/test_common/benchmark.cpp \
+	tests/bench/painter/bench_painter.cpp \
+	keyboards/tzarc/djinn/graphics/thintel15.qff.c
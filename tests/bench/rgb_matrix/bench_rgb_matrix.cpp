@@ -0,0 +1,74 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include "test_common.hpp"
+#include "benchmark.hpp"
+
+extern "C" {
+extern uint32_t rgb_matrix_bench_flushes;
+
+void advance_time(uint32_t ms);
+}
+
+struct RgbMatrixEffect {
+    uint8_t     mode;
+    std::string name;
+};
+
+// clang-format off
+const RgbMatrixEffect rgb_matrix_effects[] = {
+#define RGB_MATRIX_EFFECT(name, ...) {RGB_MATRIX_##name, #name},
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+// clang-format on
+
+class RgbMatrixBench : public TestFixture {
+   public:
+    // Renders a whole frame, which may take several calls depending on RGB_MATRIX_LED_PROCESS_LIMIT
+    void render_frame() {
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        uint32_t frame = rgb_matrix_bench_flushes;
+        for (uint8_t i = 0; i < 32 && rgb_matrix_bench_flushes == frame; i++) {
+            rgb_matrix_task();
+        }
+    }
+};
+
+TEST_F(RgbMatrixBench, Effects) {
+    for (const RgbMatrixEffect& effect : rgb_matrix_effects) {
+        std::string name = effect.name;
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        rgb_matrix_mode_noeeprom(effect.mode);
+        render_frame();
+
+        // Reactive effects only have something to draw with a steady stream of key presses
+        uint32_t frames = 0;
+        run_benchmark("rgb_matrix/" + name, [&] {
+            if (frames % 4 == 0) {
+                uint8_t key = (frames / 4) % (MATRIX_ROWS * MATRIX_COLS);
+                rgb_matrix_handle_key_event(key / MATRIX_COLS, key % MATRIX_COLS, true);
+            }
+            render_frame();
+            frames++;
+        });
+    }
+}
+
+#ifdef ENABLE_RGB_MATRIX_TYPING_HEATMAP
+TEST_F(RgbMatrixBench, TypingHeatmapKeyPress) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+    render_frame();
+
+    uint32_t presses = 0;
+    run_benchmark("rgb_matrix/typing_heatmap_key_press", [&] {
+        uint8_t key = presses % (MATRIX_ROWS * MATRIX_COLS);
+        rgb_matrix_handle_key_event(key / MATRIX_COLS, key % MATRIX_COLS, true);
+        presses++;
+    });
+}
+#endif
@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+SRC += \
+	tests/test_common/benchmark.cpp \
+	tests/bench/rgb_matrix/bench_rgb_matrix.cpp \
+	tests/bench/rgb_matrix/led_config.c
@@ -0,0 +1,8 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../rgb_matrix/config.h"
+
+#define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE
@@ -0,0 +1,84 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+BENCH_COMMON_SRC := \
+	tests/test_common/benchmark.cpp
+BENCH_COMMON_INC := \
+	tests/test_common
+
+bench_color_DEFS := -DUSE_CIE1931_CURVE
+bench_color_SRC := \
+	$(BENCH_COMMON_SRC) \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	tests/bench/color_bench.cpp
+bench_color_INC := $(BENCH_COMMON_INC)
+
+bench_debounce_common_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=10 -DDEBOUNCE=5
+bench_debounce_common_SRC := \
+	$(BENCH_COMMON_SRC) \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	tests/bench/debounce_bench.cpp
+
+bench_debounce_common_INC := $(BENCH_COMMON_INC)
+
+bench_debounce_none_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_none_INC := $(bench_debounce_common_INC)
+bench_debounce_none_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/none.c
+
+bench_debounce_sym_defer_g_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_sym_defer_g_INC := $(bench_debounce_common_INC)
+bench_debounce_sym_defer_g_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_g.c
+
+bench_debounce_sym_defer_pk_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_sym_defer_pk_INC := $(bench_debounce_common_INC)
+bench_debounce_sym_defer_pk_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+bench_debounce_sym_defer_pr_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_sym_defer_pr_INC := $(bench_debounce_common_INC)
+bench_debounce_sym_defer_pr_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pr.c
+
+bench_debounce_sym_eager_pk_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_sym_eager_pk_INC := $(bench_debounce_common_INC)
+bench_debounce_sym_eager_pk_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk.c
+
+bench_debounce_sym_eager_pr_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_sym_eager_pr_INC := $(bench_debounce_common_INC)
+bench_debounce_sym_eager_pr_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pr.c
+
+bench_debounce_asym_eager_defer_pk_DEFS := $(bench_debounce_common_DEFS)
+bench_debounce_asym_eager_defer_pk_INC := $(bench_debounce_common_INC)
+bench_debounce_asym_eager_defer_pk_SRC := $(bench_debounce_common_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c
+
+bench_deferred_exec_INC := $(BENCH_COMMON_INC)
+bench_deferred_exec_SRC := \
+	$(BENCH_COMMON_SRC) \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	tests/bench/deferred_exec_bench.cpp
+
+bench_wear_leveling_DEFS := \
+	-DWEAR_LEVELING_TESTS \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+bench_wear_leveling_SRC := \
+	$(BENCH_COMMON_SRC) \
+	$(LIB_PATH)/fnv/qmk_fnv_type_validation.c \
+	$(LIB_PATH)/fnv/hash_32a.c \
+	$(LIB_PATH)/fnv/hash_64a.c \
+	$(QUANTUM_PATH)/wear_leveling/wear_leveling.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/backing_mocks.cpp \
+	tests/bench/wear_leveling_bench.cpp
+bench_wear_leveling_INC := \
+	$(BENCH_COMMON_INC) \
+	$(LIB_PATH)/fnv \
+	$(QUANTUM_PATH)/wear_leveling \
+	$(QUANTUM_PATH)/wear_leveling/tests
@@ -0,0 +1,43 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "backing_mocks.hpp"
+#include "benchmark.hpp"
+
+// Writes go through the mocked backing store, so consolidations are included in the measurements
+class WearLevelingBench : public testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+TEST_F(WearLevelingBench, WriteUnchanged) {
+    uint8_t value = 0;
+    run_benchmark("wear_leveling_write/unchanged", [&] { do_not_optimize(wear_leveling_write(0, &value, sizeof(value))); });
+}
+
+TEST_F(WearLevelingBench, WriteByte) {
+    uint32_t writes = 0;
+    run_benchmark("wear_leveling_write/1_byte", [&] {
+        // Changes on every pass over the logical area, so no write is skipped as unchanged
+        uint8_t value = (writes / WEAR_LEVELING_LOGICAL_SIZE + 1) & 0xFF;
+        do_not_optimize(wear_leveling_write(writes % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value)));
+        writes++;
+    });
+}
+
+TEST_F(WearLevelingBench, WriteBlock) {
+    std::array<uint8_t, 32> block;
+    std::iota(block.begin(), block.end(), 0);
+    uint32_t writes = 0;
+    run_benchmark("wear_leveling_write/32_bytes", [&] {
+        block[0] = writes & 0xFF;
+        do_not_optimize(wear_leveling_write((writes * block.size()) % WEAR_LEVELING_LOGICAL_SIZE, block.data(), block.size()));
+        writes++;
+    });
+}
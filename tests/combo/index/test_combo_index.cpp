@@ -0,0 +1,80 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ComboIndex : public TestFixture {};
+
+TEST_F(ComboIndex, TwoKeyCombo) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, LongerOverlappingComboWins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, CombosSharingAKey) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 0, 1, KC_J);
+    KeymapKey  key_k(0, 1, 1, KC_K);
+    KeymapKey  key_l(0, 2, 1, KC_L);
+    set_keymap({key_j, key_k, key_l});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_j, key_k});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_k, key_l});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, KeyInSameBucketIsNotACombo) {
+    TestDriver driver;
+    InSequence s;
+    // KC_8 hashes into the same bucket as KC_A
+    KeymapKey key_8(0, 0, 2, KC_8);
+    KeymapKey key_b(0, 1, 0, KC_B);
+    set_keymap({key_8, key_b});
+
+    EXPECT_REPORT(driver, (KC_8));
+    EXPECT_REPORT(driver, (KC_8, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_8, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, UnrelatedKeyPassesThrough) {
+    TestDriver driver;
+    KeymapKey  key_z(0, 3, 3, KC_Z);
+    set_keymap({key_z});
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_z);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,20 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { ab, abc, jk, kl };
+
+uint16_t const ab_combo[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const abc_combo[] = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const kl_combo[]  = {KC_K, KC_L, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab]  = COMBO(ab_combo, KC_X),
+    [abc] = COMBO(abc_combo, KC_Y),
+    [jk]  = COMBO(jk_combo, KC_ESC),
+    [kl]  = COMBO(kl_combo, KC_TAB),
+};
+// clang-format on
@@ -0,0 +1,272 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct Invocation {
+    uint32_t  trigger_time;
+    uintptr_t id;
+};
+
+static std::vector<Invocation> invocations;
+static uint32_t                repeat_delay = 0;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({trigger_time, (uintptr_t)cb_arg});
+    return repeat_delay;
+}
+
+class DeferredExec : public TestFixture {
+   protected:
+    uint32_t start;
+
+    void SetUp() override {
+        invocations.clear();
+        repeat_delay = 0;
+
+        // The fixture resets the clock, but the executor table outlives each test -- keep moving forward
+        static uint32_t next_start = 1000;
+        start                      = next_start;
+        next_start += 100000;
+        set_time(start);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+};
+
+TEST_F(DeferredExec, RunsInTriggerOrder) {
+    EXPECT_NE(defer_exec(30, record_callback, (void *)3), INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(defer_exec(10, record_callback, (void *)1), INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(defer_exec(20, record_callback, (void *)2), INVALID_DEFERRED_TOKEN);
+
+    run_for(9);
+    EXPECT_TRUE(invocations.empty());
+
+    run_for(21);
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[0].trigger_time, start + 10);
+    EXPECT_EQ(invocations[1].id, 2);
+    EXPECT_EQ(invocations[2].id, 3);
+    EXPECT_FALSE(deferred_exec_next_trigger(nullptr));
+}
+
+TEST_F(DeferredExec, RepeatsUntilCancelled) {
+    repeat_delay         = 5;
+    deferred_token token = defer_exec(5, record_callback, nullptr);
+
+    run_for(25);
+    ASSERT_EQ(invocations.size(), 5);
+    for (size_t i = 0; i < invocations.size(); ++i) {
+        EXPECT_EQ(invocations[i].trigger_time, start + 5 + 5 * i);
+    }
+
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    EXPECT_FALSE(cancel_deferred_exec(token));
+    run_for(25);
+    EXPECT_EQ(invocations.size(), 5);
+}
+
+TEST_F(DeferredExec, ExtendPostponesExecution) {
+    deferred_token first  = defer_exec(10, record_callback, (void *)1);
+    deferred_token second = defer_exec(20, record_callback, (void *)2);
+
+    run_for(5);
+    EXPECT_TRUE(extend_deferred_exec(first, 30));
+
+    uint32_t trigger_time = 0;
+    EXPECT_TRUE(deferred_exec_next_trigger(&trigger_time));
+    EXPECT_EQ(trigger_time, start + 20);
+
+    run_for(40);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[0].id, 2);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].trigger_time, start + 35);
+
+    EXPECT_FALSE(extend_deferred_exec(second, 10));
+}
+
+TEST_F(DeferredExec, FailsWhenFull) {
+    deferred_token tokens[MAX_DEFERRED_EXECUTORS];
+    for (auto &token : tokens) {
+        token = defer_exec(10, record_callback, nullptr);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(10, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+
+    // A stale token must not affect the executor that reuses its entry
+    EXPECT_TRUE(cancel_deferred_exec(tokens[1]));
+    deferred_token reused = defer_exec(10, record_callback, nullptr);
+    EXPECT_NE(reused, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(reused, tokens[1]);
+    EXPECT_FALSE(cancel_deferred_exec(tokens[1]));
+
+    run_for(10);
+    EXPECT_EQ(invocations.size(), MAX_DEFERRED_EXECUTORS);
+}
+
+TEST_F(DeferredExec, BehindScheduleDoesNotStarveOthers) {
+    repeat_delay         = 1;
+    deferred_token token = defer_exec(1, record_callback, (void *)1);
+
+    // Fall well behind before the next pass
+    advance_time(50);
+    deferred_exec_task();
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].trigger_time, start + 1);
+
+    // The lagging executor runs once per pass, catching up on its intended trigger times
+    EXPECT_NE(defer_exec(1, record_callback, (void *)2), INVALID_DEFERRED_TOKEN);
+    advance_time(1);
+    deferred_exec_task();
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].trigger_time, start + 2);
+    EXPECT_EQ(invocations[2].id, 2);
+
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    repeat_delay = 0;
+    run_for(5);
+}
+
+TEST_F(DeferredExec, LargeTableRunsEachExecutorInOrder) {
+    static deferred_executor_t  table[200] = {};
+    uint32_t                    last       = 0;
+    std::vector<deferred_token> tokens;
+
+    for (uint32_t i = 0; i < 200; ++i) {
+        deferred_token token = defer_exec_advanced(table, 200, 1 + (i * 37) % 101, record_callback, (void *)(uintptr_t)i);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(defer_exec_advanced(table, 200, 1, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+
+    // Cancel every other executor
+    for (size_t i = 0; i < tokens.size(); i += 2) {
+        EXPECT_TRUE(cancel_deferred_exec_advanced(table, 200, tokens[i]));
+    }
+
+    uint32_t trigger_time = 0;
+    EXPECT_TRUE(deferred_exec_next_trigger_advanced(table, 200, &trigger_time));
+    EXPECT_EQ(trigger_time, start + 1); // i = 101
+
+    for (uint32_t i = 0; i < 110; ++i) {
+        advance_time(1);
+        deferred_exec_advanced_task(table, 200, &last);
+    }
+
+    ASSERT_EQ(invocations.size(), 100);
+    EXPECT_TRUE(std::is_sorted(invocations.begin(), invocations.end(), [](const Invocation &a, const Invocation &b) { return a.trigger_time < b.trigger_time; }));
+    for (auto &invocation : invocations) {
+        EXPECT_EQ(invocation.id % 2, 1);
+        EXPECT_EQ(invocation.trigger_time, start + 1 + (invocation.id * 37) % 101);
+    }
+    EXPECT_FALSE(deferred_exec_next_trigger_advanced(table, 200, nullptr));
+}
+
+TEST_F(DeferredExec, StaleTokensInLargeTable) {
+    static deferred_executor_t table[200] = {};
+    uint32_t                   last       = 0;
+
+    deferred_token tokens[200];
+    for (auto &token : tokens) {
+        token = defer_exec_advanced(table, 200, 1000, record_callback, nullptr);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    }
+
+    // With the table full, each new executor reuses the entry just freed -- the old token must never match it
+    deferred_token stale = tokens[150];
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_TRUE(cancel_deferred_exec_advanced(table, 200, stale));
+        deferred_token token = defer_exec_advanced(table, 200, 10, record_callback, (void *)1);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        EXPECT_NE(token, stale);
+        EXPECT_FALSE(cancel_deferred_exec_advanced(table, 200, stale));
+        EXPECT_FALSE(extend_deferred_exec_advanced(table, 200, stale, 10));
+        stale = token;
+    }
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        advance_time(1);
+        deferred_exec_advanced_task(table, 200, &last);
+    }
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].id, 1);
+
+    for (auto &token : tokens) {
+        cancel_deferred_exec_advanced(table, 200, token);
+    }
+    EXPECT_FALSE(deferred_exec_next_trigger_advanced(table, 200, nullptr));
+}
+
+static deferred_token self_token = INVALID_DEFERRED_TOKEN;
+
+static uint32_t extend_self_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({trigger_time, (uintptr_t)cb_arg});
+    if (invocations.size() > 1) {
+        return 0;
+    }
+    EXPECT_TRUE(extend_deferred_exec(self_token, 20));
+    return 5;
+}
+
+TEST_F(DeferredExec, ExtendSelfInsideCallback) {
+    self_token = defer_exec(10, extend_self_callback, nullptr);
+    ASSERT_NE(self_token, INVALID_DEFERRED_TOKEN);
+
+    // The returned delay is added on top of the extension
+    run_for(40);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[0].trigger_time, start + 10);
+    EXPECT_EQ(invocations[1].trigger_time, start + 35);
+    EXPECT_FALSE(deferred_exec_next_trigger(nullptr));
+}
+
+static uint32_t requeue_self_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({trigger_time, (uintptr_t)cb_arg});
+    if (cb_arg == nullptr) {
+        EXPECT_TRUE(cancel_deferred_exec(self_token));
+        self_token = defer_exec(20, requeue_self_callback, (void *)1);
+        EXPECT_NE(self_token, INVALID_DEFERRED_TOKEN);
+    }
+    return 5;
+}
+
+TEST_F(DeferredExec, RequeueSelfInsideCallback) {
+    // Fill the table, so that the requeued executor has to reuse the callback's own entry
+    deferred_token others[MAX_DEFERRED_EXECUTORS - 1];
+    for (auto &token : others) {
+        token = defer_exec(1000, record_callback, (void *)2);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    }
+    self_token = defer_exec(10, requeue_self_callback, nullptr);
+    ASSERT_NE(self_token, INVALID_DEFERRED_TOKEN);
+
+    // The returned delay applies to the cancelled executor, not the one requeued in its place
+    run_for(35);
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[0].trigger_time, start + 10);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].trigger_time, start + 30);
+    EXPECT_EQ(invocations[2].trigger_time, start + 35);
+
+    EXPECT_TRUE(cancel_deferred_exec(self_token));
+    for (auto &token : others) {
+        EXPECT_TRUE(cancel_deferred_exec(token));
+    }
+}
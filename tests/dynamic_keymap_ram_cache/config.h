@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TOTAL_EEPROM_BYTE_COUNT 1024
+#define DYNAMIC_KEYMAP_RAM_CACHE
+#define DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY 50
+#define DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_SIZE 16
@@ -0,0 +1,139 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class DynamicKeymapRamCache : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+        dynamic_keymap_flush();
+    }
+
+    uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        const uint8_t *address = (const uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapRamCache, WritesAreServedFromRam) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    dynamic_keymap_set_keycode(0, 2, 3, KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 2, 3), KC_B);
+    EXPECT_EQ(eeprom_keycode(0, 2, 3), KC_NO);
+    EXPECT_TRUE(dynamic_keymap_is_dirty());
+
+    idle_for(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY + 1);
+    EXPECT_EQ(eeprom_keycode(0, 2, 3), KC_B);
+    EXPECT_FALSE(dynamic_keymap_is_dirty());
+}
+
+TEST_F(DynamicKeymapRamCache, FlushIsDelayedUntilWritesStop) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    idle_for(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY / 2);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_B);
+    idle_for(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY / 2 + 1);
+    EXPECT_EQ(eeprom_keycode(0, 0, 0), KC_NO);
+    EXPECT_TRUE(dynamic_keymap_is_dirty());
+
+    idle_for(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY);
+    EXPECT_EQ(eeprom_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(eeprom_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(DynamicKeymapRamCache, BufferIsFlushedInChunks) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    uint8_t data[MATRIX_COLS * 2];
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        data[col * 2]     = 0;
+        data[col * 2 + 1] = KC_A + col;
+    }
+    dynamic_keymap_set_buffer(0, sizeof(data), data);
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, col), KC_A + col);
+    }
+
+    idle_for(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY);
+    run_one_scan_loop();
+    EXPECT_TRUE(dynamic_keymap_is_dirty());
+    EXPECT_EQ(eeprom_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(eeprom_keycode(0, 0, MATRIX_COLS - 1), KC_NO);
+
+    idle_for((sizeof(data) + DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_SIZE - 1) / DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_SIZE);
+    EXPECT_FALSE(dynamic_keymap_is_dirty());
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        EXPECT_EQ(eeprom_keycode(0, 0, col), KC_A + col);
+    }
+}
+
+TEST_F(DynamicKeymapRamCache, MacrosStayInvalidUntilFlushed) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    uint16_t size = dynamic_keymap_macro_get_buffer_size();
+    uint8_t  data[64];
+    memset(data, 'a', sizeof(data));
+    data[sizeof(data) - 1] = 0;
+
+    // Same sequence as the host, invalidate the buffer while it is being written
+    uint8_t invalid = 0xFF;
+    dynamic_keymap_macro_set_buffer(size - 1, 1, &invalid);
+    dynamic_keymap_macro_set_buffer(0, sizeof(data), data);
+    uint8_t valid = 0;
+    dynamic_keymap_macro_set_buffer(size - 1, 1, &valid);
+
+    idle_for(DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY);
+    run_one_scan_loop();
+    EXPECT_TRUE(dynamic_keymap_is_dirty());
+    uint8_t last;
+    dynamic_keymap_macro_get_buffer(size - 1, 1, &last);
+    EXPECT_EQ(last, 0);
+
+    // Partially flushed, so the copy in EEPROM must not be considered valid
+    uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
+    eeprom_read_block(buffer, 0, sizeof(buffer));
+    EXPECT_EQ(buffer[TOTAL_EEPROM_BYTE_COUNT - 1], 0xFF);
+
+    dynamic_keymap_flush();
+    EXPECT_FALSE(dynamic_keymap_is_dirty());
+    eeprom_read_block(buffer, 0, sizeof(buffer));
+    EXPECT_EQ(buffer[TOTAL_EEPROM_BYTE_COUNT - 1], 0);
+    EXPECT_EQ(memcmp(&buffer[TOTAL_EEPROM_BYTE_COUNT - size], data, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymapRamCache, ResetRestoresErasedEeprom) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    // Erased behind the mirror's back, as eeconfig_init() does before resetting the keymap
+    uintptr_t start = (uintptr_t)dynamic_keymap_key_to_eeprom_address(0, 0, 0);
+    uint8_t   erased[TOTAL_EEPROM_BYTE_COUNT];
+    memset(erased, 0xFF, sizeof(erased));
+    eeprom_write_block(erased, (void *)start, TOTAL_EEPROM_BYTE_COUNT - start);
+
+    dynamic_keymap_reset();
+    dynamic_keymap_macro_reset();
+    dynamic_keymap_flush();
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        EXPECT_EQ(eeprom_keycode(0, 0, col), dynamic_keymap_get_keycode(0, 0, col));
+    }
+    uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
+    eeprom_read_block(buffer, 0, sizeof(buffer));
+    EXPECT_EQ(buffer[TOTAL_EEPROM_BYTE_COUNT - 1], 0);
+}
@@ -0,0 +1,147 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+};
+
+TEST_F(LatencyTrace, RegularKeyIsReportedImmediately) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_stats_t stats;
+    EXPECT_TRUE(latency_trace_get_stats(LATENCY_TRACE_TOTAL, &stats));
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.max_us, 0);
+
+    latency_trace_event_t event;
+    EXPECT_TRUE(latency_trace_get_event(0, &event));
+    EXPECT_FALSE(event.pressed);
+    EXPECT_EQ(event.key.row, 0);
+    EXPECT_EQ(event.key.col, 0);
+    EXPECT_TRUE(latency_trace_get_event(1, &event));
+    EXPECT_TRUE(event.pressed);
+    EXPECT_FALSE(latency_trace_get_event(2, &event));
+}
+
+TEST_F(LatencyTrace, TappingDelayIsAttributedToProcessing) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 7, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    idle_for(TAPPING_TERM);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_event_t event;
+    EXPECT_TRUE(latency_trace_get_event(1, &event));
+    EXPECT_TRUE(event.pressed);
+    EXPECT_EQ(event.debounce_us, 0);
+    // Per-event deltas saturate, the aggregated statistics don't
+    EXPECT_EQ(event.process_us, UINT16_MAX);
+    EXPECT_EQ(event.report_us, 0);
+
+    latency_trace_stats_t stats;
+    EXPECT_TRUE(latency_trace_get_stats(LATENCY_TRACE_PROCESS, &stats));
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.min_us, 0);
+    EXPECT_EQ(stats.max_us, TAPPING_TERM * 1000);
+    EXPECT_EQ(stats.avg_us, TAPPING_TERM * 1000 / 2);
+}
+
+TEST_F(LatencyTrace, UnreportedEventsAreDiscarded) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_layer = KeymapKey(0, 0, 0, MO(1));
+    auto       key_a     = KeymapKey(1, 1, 0, KC_A);
+
+    set_keymap({key_layer, key_a});
+
+    // Layer changes never produce a report, so the event must not wait for the next one
+    EXPECT_NO_REPORT(driver);
+    key_layer.press();
+    run_one_scan_loop();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_stats_t stats;
+    EXPECT_TRUE(latency_trace_get_stats(LATENCY_TRACE_TOTAL, &stats));
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max_us, 0);
+    EXPECT_EQ(latency_trace_dropped_count(), 0);
+
+    latency_trace_event_t event;
+    EXPECT_TRUE(latency_trace_get_event(0, &event));
+    EXPECT_EQ(event.key.col, 1);
+    EXPECT_FALSE(latency_trace_get_event(1, &event));
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_layer.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, EventsInFlightAreDropped) {
+    TestDriver driver;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       key_a            = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b            = KeymapKey(0, 2, 0, KC_B);
+
+    set_keymap({mod_tap_hold_key, key_a, key_b});
+
+    // The tap-hold key holds back all three events, one more than can be in flight
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(latency_trace_dropped_count(), 1);
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    mod_tap_hold_key.release();
+    key_a.release();
+    key_b.release();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
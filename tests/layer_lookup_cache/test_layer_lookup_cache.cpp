@@ -0,0 +1,108 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {};
+
+TEST_F(LayerLookupCache, FollowsLayerState) {
+    TestDriver driver;
+    KeymapKey  layer_key = KeymapKey{0, 0, 0, MO(1)};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+    KeymapKey  key_b     = KeymapKey{1, 1, 0, KC_B};
+
+    set_keymap({layer_key, key_a, key_b, KeymapKey{1, 0, 0, KC_TRANSPARENT}});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    EXPECT_EQ(layer_switch_get_layer(layer_key.position), 0);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    // State changes that bypass layer_state_set() are picked up as well
+    layer_state = (layer_state_t)1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    layer_state = 0;
+
+    default_layer_set((layer_state_t)1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    default_layer_set((layer_state_t)1 << 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, MomentaryLayer) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key = KeymapKey{0, 0, 0, MO(1)};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+    KeymapKey  key_b     = KeymapKey{1, 1, 0, KC_B};
+
+    set_keymap({layer_key, key_a, key_b, KeymapKey{1, 0, 0, KC_TRANSPARENT}});
+
+    EXPECT_REPORT(driver, (key_a.report_code));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (key_b.report_code));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (key_a.report_code));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, TransparentLayersFallThrough) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 1, 0, KC_A};
+    KeymapKey  key_b = KeymapKey{2, 1, 0, KC_B};
+
+    set_keymap({key_a, KeymapKey{1, 1, 0, KC_TRANSPARENT}, key_b, KeymapKey{3, 1, 0, KC_TRANSPARENT}});
+
+    layer_state_set(0b1010);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_state_set(0b1110);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, InvalidatedOnKeymapChange) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_a, KeymapKey{1, 1, 0, KC_TRANSPARENT}});
+
+    layer_state_set(0b10);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    // The keymap changed without a layer state change
+    set_keymap({key_a, KeymapKey{1, 1, 0, KC_B}});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
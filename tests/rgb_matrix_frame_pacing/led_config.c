@@ -0,0 +1,47 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+void advance_time(uint32_t ms);
+
+// Time it takes to render a single LED
+uint32_t rgb_matrix_test_led_cost = 0;
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    advance_time(rgb_matrix_test_led_cost);
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9 },
+        { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 },
+        { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 },
+        { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39 }
+    }, {
+        {   0,  0 }, {  25,  0 }, {  50,  0 }, {  75,  0 }, { 100,  0 }, { 124,  0 }, { 149,  0 }, { 174,  0 }, { 199,  0 }, { 224,  0 },
+        {   0, 21 }, {  25, 21 }, {  50, 21 }, {  75, 21 }, { 100, 21 }, { 124, 21 }, { 149, 21 }, { 174, 21 }, { 199, 21 }, { 224, 21 },
+        {   0, 43 }, {  25, 43 }, {  50, 43 }, {  75, 43 }, { 100, 43 }, { 124, 43 }, { 149, 43 }, { 174, 43 }, { 199, 43 }, { 224, 43 },
+        {   0, 64 }, {  25, 64 }, {  50, 64 }, {  75, 64 }, { 100, 64 }, { 124, 64 }, { 149, 64 }, { 174, 64 }, { 199, 64 }, { 224, 64 }
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 1, 1, 1, 4, 4, 1, 1, 1, 1
+    }
+};
+// clang-format on
@@ -0,0 +1,71 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+extern uint32_t rgb_matrix_test_led_cost;
+
+void advance_time(uint32_t ms);
+}
+
+class RgbMatrixFramePacing : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_test_led_cost = 0;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    }
+
+    rgb_matrix_frame_stats_t run(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+        rgb_matrix_frame_stats_t stats;
+        rgb_matrix_get_frame_stats(&stats);
+        return stats;
+    }
+};
+
+TEST_F(RgbMatrixFramePacing, RendersAtTargetFrameRate) {
+    run(2000);
+    rgb_matrix_frame_stats_t before = run(0);
+    rgb_matrix_frame_stats_t after  = run(1000);
+
+    EXPECT_EQ(after.fps, RGB_MATRIX_TARGET_FPS);
+    EXPECT_EQ(after.frames - before.frames, RGB_MATRIX_TARGET_FPS);
+    EXPECT_EQ(after.dropped, before.dropped);
+    // Free rendering allows the whole matrix in one go
+    EXPECT_EQ(after.batch_size, RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixFramePacing, ShrinksBatchToBudget) {
+    rgb_matrix_test_led_cost = 1;
+    rgb_matrix_frame_stats_t stats = run(500);
+
+    // 4 LEDs at 1ms each fit in 4.5ms
+    EXPECT_EQ(stats.batch_size, 4);
+}
+
+TEST_F(RgbMatrixFramePacing, GrowsBatchWhenCheaper) {
+    rgb_matrix_test_led_cost = 1;
+    run(500);
+
+    rgb_matrix_test_led_cost = 0;
+    rgb_matrix_frame_stats_t stats = run(500);
+    EXPECT_EQ(stats.batch_size, RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixFramePacing, CountsDroppedFrames) {
+    rgb_matrix_test_led_cost = 1;
+    run(500);
+
+    // 40 LEDs take 40ms to render, so each frame starts at least one 20ms interval late
+    rgb_matrix_frame_stats_t before = run(0);
+    rgb_matrix_frame_stats_t after  = run(1000);
+    uint32_t                 frames = after.frames - before.frames;
+    EXPECT_GT(frames, 0);
+    EXPECT_LT(after.fps, RGB_MATRIX_TARGET_FPS / 2);
+    EXPECT_GE(after.dropped - before.dropped, frames);
+}
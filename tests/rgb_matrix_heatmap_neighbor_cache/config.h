@@ -0,0 +1,18 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 36
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#define ENABLE_RGB_MATRIX_TYPING_HEATMAP
+
+#define RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP 32
+#define RGB_MATRIX_TYPING_HEATMAP_SPREAD 40
+#define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
+#define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE
+// Too small for every key, so that the last keys fall back to scanning the matrix
+#define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE_SIZE 128
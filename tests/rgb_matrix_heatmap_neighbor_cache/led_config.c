@@ -0,0 +1,41 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
+
+// Staggered rows wired as a serpentine, with a thumb row that has no LEDs under its outer keys
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {      0,      1,      2,      3,      4,      5,      6,      7,      8,      9 },
+        {     19,     18,     17,     16,     15,     14,     13,     12,     11,     10 },
+        {     20,     21,     22,     23,     24,     25,     26,     27,     28,     29 },
+        { NO_LED, NO_LED,     30,     31,     32,     33,     34,     35, NO_LED, NO_LED }
+    }, {
+        {  10,  0 }, {  30,  0 }, {  50,  0 }, {  70,  0 }, {  90,  0 }, { 110,  0 }, { 130,  0 }, { 150,  0 }, { 170,  0 }, { 190,  0 },
+        { 195, 16 }, { 175, 16 }, { 155, 16 }, { 135, 16 }, { 115, 16 }, {  95, 16 }, {  75, 16 }, {  55, 16 }, {  35, 16 }, {  15, 16 },
+        {  20, 32 }, {  40, 32 }, {  60, 32 }, {  80, 32 }, { 100, 32 }, { 120, 32 }, { 140, 32 }, { 160, 32 }, { 180, 32 }, { 200, 32 },
+        {  60, 52 }, {  78, 52 }, {  96, 52 }, { 114, 52 }, { 132, 52 }, { 150, 52 }
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 1, 1, 1, 1, 1
+    }
+};
+// clang-format on
@@ -0,0 +1,75 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include "test_common.hpp"
+
+class RgbMatrixHeatmapNeighborCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+    }
+
+    // Some heat already, with a few keys close to saturating
+    static void fill(uint8_t buffer[MATRIX_ROWS][MATRIX_COLS]) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                buffer[row][col] = (row * MATRIX_COLS + col) * 29 % 251;
+            }
+        }
+    }
+
+    // The heat spread by a key press, found by comparing the pressed key against every other key
+    static void full_scan(uint8_t buffer[MATRIX_ROWS][MATRIX_COLS], uint8_t row, uint8_t col) {
+        uint8_t led = g_led_config.matrix_co[row][col];
+        if (led == NO_LED) {
+            return;
+        }
+        buffer[row][col] = std::min(buffer[row][col] + RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP, 255);
+        for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+            for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                uint8_t target = g_led_config.matrix_co[i_row][i_col];
+                if (target == NO_LED || (i_row == row && i_col == col)) {
+                    continue;
+                }
+                int32_t dx       = g_led_config.point[target].x - g_led_config.point[led].x;
+                int32_t dy       = g_led_config.point[target].y - g_led_config.point[led].y;
+                int32_t square   = dx * dx + dy * dy;
+                int32_t in_reach = (RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1) * (RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1);
+                if (square >= in_reach) {
+                    continue;
+                }
+                int32_t amount       = std::min<int32_t>(RGB_MATRIX_TYPING_HEATMAP_SPREAD - static_cast<int32_t>(std::sqrt(square)), RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT);
+                buffer[i_row][i_col] = std::min(buffer[i_row][i_col] + amount, 255);
+            }
+        }
+    }
+};
+
+TEST_F(RgbMatrixHeatmapNeighborCache, MatchesFullScan) {
+    uint8_t initial[MATRIX_ROWS][MATRIX_COLS];
+    fill(initial);
+
+    uint32_t heated = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t expected[MATRIX_ROWS][MATRIX_COLS];
+            fill(expected);
+            full_scan(expected, row, col);
+
+            fill(g_rgb_frame_buffer);
+            rgb_matrix_handle_key_event(row, col, true);
+
+            for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+                for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                    EXPECT_EQ(g_rgb_frame_buffer[i_row][i_col], expected[i_row][i_col]) << "pressed " << +row << "," << +col << ", target " << +i_row << "," << +i_col;
+                    heated += expected[i_row][i_col] != initial[i_row][i_col];
+                }
+            }
+        }
+    }
+    // The layout has to be dense enough for the cache to run out of space
+    EXPECT_GT(heated, RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_CACHE_SIZE);
+}
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+TASK_PROFILER_ENABLE = yes
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_combos.c
+
+SRC += tests/test_common/trace_replay.cpp tests/test_common/trace_replay_test.cpp tests/simulator/simulator_keymap.c
@@ -0,0 +1,22 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { jk_esc, df_tab, sd_bspc, io_enter, wer_caps };
+
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const df_combo[]  = {KC_D, KC_F, COMBO_END};
+uint16_t const sd_combo[]  = {KC_S, KC_D, COMBO_END};
+uint16_t const io_combo[]  = {KC_I, KC_O, COMBO_END};
+uint16_t const wer_combo[] = {KC_W, KC_E, KC_R, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [jk_esc]   = COMBO(jk_combo, KC_ESCAPE),
+    [df_tab]   = COMBO(df_combo, KC_TAB),
+    [sd_bspc]  = COMBO(sd_combo, KC_BACKSPACE),
+    [io_enter] = COMBO(io_combo, KC_ENTER),
+    [wer_caps] = COMBO(wer_combo, KC_CAPS_LOCK)
+};
+// clang-format on
@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const key_override_t backspace_override = ko_make_basic(MOD_MASK_SHIFT, KC_BACKSPACE, KC_DELETE);
+const key_override_t comma_override     = ko_make_basic(MOD_MASK_SHIFT, KC_COMMA, KC_SEMICOLON);
+const key_override_t dot_override       = ko_make_basic(MOD_MASK_SHIFT, KC_DOT, KC_COLON);
+const key_override_t slash_override     = ko_make_basic(MOD_MASK_SHIFT, KC_SLASH, KC_QUESTION);
+
+// clang-format off
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &backspace_override,
+    &comma_override,
+    &dot_override,
+    &slash_override,
+    NULL
+};
+// clang-format on
@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+const uint16_t simulator_keymap[MATRIX_ROWS][MATRIX_COLS] = {
+    {KC_Q,         KC_W,         KC_E,         KC_R,         KC_T,   KC_Y,   KC_U,         KC_I,         KC_O,         KC_P           },
+    {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G,   KC_H,   RSFT_T(KC_J), RCTL_T(KC_K), LALT_T(KC_L), RGUI_T(KC_SCLN)},
+    {KC_Z,         KC_X,         KC_C,         KC_V,         KC_B,   KC_N,   KC_M,         KC_COMM,      KC_DOT,       KC_SLSH        },
+    {KC_LCTL,      KC_LGUI,      KC_LALT,      KC_LSFT,      KC_SPC, KC_ENT, KC_BSPC,      KC_RSFT,      KC_RALT,      KC_RCTL        }
+};
+// clang-format on
@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+TASK_PROFILER_ENABLE = yes
+
+SRC += tests/test_common/trace_replay.cpp tests/test_common/trace_replay_test.cpp $(TEST_PATH)/simulator_keymap.c
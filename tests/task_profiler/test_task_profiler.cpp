@@ -0,0 +1,77 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class TaskProfiler : public TestFixture {
+   public:
+    void SetUp() override {
+        task_profiler_reset();
+    }
+};
+
+TEST_F(TaskProfiler, EmptyStageReportsNoSamples) {
+    task_profiler_stats_t stats;
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_RGB_MATRIX_TASK, &stats));
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.min, 0);
+    EXPECT_EQ(stats.max, 0);
+}
+
+TEST_F(TaskProfiler, InvalidStageIsRejected) {
+    task_profiler_stats_t stats;
+    EXPECT_FALSE(task_profiler_get_stats(TASK_PROFILER_STAGE_COUNT, &stats));
+}
+
+TEST_F(TaskProfiler, PercentilesOverWindow) {
+    for (uint32_t i = 1; i <= 10; i++) {
+        task_profiler_record(TASK_PROFILER_QUANTUM_TASK, i * 10);
+    }
+
+    task_profiler_stats_t stats;
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_QUANTUM_TASK, &stats));
+    EXPECT_EQ(stats.count, 10);
+    EXPECT_EQ(stats.min, 10);
+    EXPECT_EQ(stats.max, 100);
+    EXPECT_EQ(stats.p50, 50);
+    EXPECT_EQ(stats.p99, 100);
+    EXPECT_EQ(stats.total, 550);
+}
+
+TEST_F(TaskProfiler, RingBufferKeepsMostRecentSamples) {
+    // Fill the window with large samples, then overwrite all of them with small ones
+    for (uint32_t i = 0; i < TASK_PROFILER_SAMPLE_COUNT; i++) {
+        task_profiler_record(TASK_PROFILER_MATRIX_TASK, 1000);
+    }
+    for (uint32_t i = 0; i < TASK_PROFILER_SAMPLE_COUNT; i++) {
+        task_profiler_record(TASK_PROFILER_MATRIX_TASK, 5);
+    }
+
+    task_profiler_stats_t stats;
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_MATRIX_TASK, &stats));
+    EXPECT_EQ(stats.count, 2 * TASK_PROFILER_SAMPLE_COUNT);
+    EXPECT_EQ(stats.max, 1000);
+    EXPECT_EQ(stats.p50, 5);
+    EXPECT_EQ(stats.p99, 5);
+}
+
+TEST_F(TaskProfiler, ScanLoopIsInstrumented) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+
+    task_profiler_stats_t stats;
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_KEYBOARD_TASK, &stats));
+    EXPECT_EQ(stats.count, 5);
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_MATRIX_TASK, &stats));
+    EXPECT_EQ(stats.count, 5);
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_QUANTUM_TASK, &stats));
+    EXPECT_EQ(stats.count, 5);
+    EXPECT_TRUE(task_profiler_get_stats(TASK_PROFILER_HOUSEKEEPING_TASK, &stats));
+    EXPECT_EQ(stats.count, 5);
+}
@@ -0,0 +1,86 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace {
+struct BenchmarkResult {
+    std::string name;
+    uint64_t    iterations;
+    double      real_ns;
+    double      cpu_ns;
+};
+
+std::vector<BenchmarkResult> results;
+
+std::string json_escape(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+class BenchmarkEnvironment : public testing::Environment {
+   public:
+    void TearDown() override {
+        const char* path = std::getenv("QMK_BENCH_OUTPUT");
+        if (!path) {
+            return;
+        }
+
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "unable to write benchmark results to " << path << std::endl;
+            return;
+        }
+
+        std::time_t now = std::time(nullptr);
+        char        date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+        file << "{" << std::endl;
+        file << "  \"context\": {" << std::endl;
+        file << "    \"date\": \"" << date << "\"," << std::endl;
+        file << "    \"library_build_type\": \"release\"" << std::endl;
+        file << "  }," << std::endl;
+        file << "  \"benchmarks\": [" << std::endl;
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& result = results[i];
+            file << "    {";
+            file << "\"name\": \"" << json_escape(result.name) << "\", ";
+            file << "\"run_name\": \"" << json_escape(result.name) << "\", ";
+            file << "\"run_type\": \"iteration\", ";
+            file << "\"iterations\": " << result.iterations << ", ";
+            file << std::fixed << std::setprecision(3);
+            file << "\"real_time\": " << result.real_ns << ", ";
+            file << "\"cpu_time\": " << result.cpu_ns << ", ";
+            file << "\"time_unit\": \"ns\"";
+            file << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+        file << "  ]" << std::endl;
+        file << "}" << std::endl;
+    }
+};
+
+testing::Environment* const benchmark_environment = testing::AddGlobalTestEnvironment(new BenchmarkEnvironment);
+} // namespace
+
+std::chrono::nanoseconds benchmark_min_time() {
+    const char* min_time_ms = std::getenv("QMK_BENCH_MIN_TIME_MS");
+    return std::chrono::milliseconds(min_time_ms ? std::atoi(min_time_ms) : 50);
+}
+
+void benchmark_record(const std::string& name, uint64_t iterations, double real_ns, double cpu_ns) {
+    results.push_back({name, iterations, real_ns, cpu_ns});
+    std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(1) << std::setw(12) << real_ns << " ns " << std::setw(12) << cpu_ns << " ns cpu " << std::setw(12) << iterations << std::endl;
+}
@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+/**
+ * @brief Prevents the compiler from optimising away the computation of `value`.
+ */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Records the result of a benchmark, to be written out as JSON once all tests have run.
+ */
+void benchmark_record(const std::string& name, uint64_t iterations, double real_ns, double cpu_ns);
+
+/**
+ * @brief Minimum time each benchmark runs for, `QMK_BENCH_MIN_TIME_MS` if set.
+ */
+std::chrono::nanoseconds benchmark_min_time();
+
+/**
+ * @brief Runs `fn` repeatedly until `benchmark_min_time()` has elapsed and records the mean time per iteration.
+ *
+ * The results of every benchmark are written in the Google Benchmark JSON format to the path in
+ * `QMK_BENCH_OUTPUT`, if set, so existing tooling can be used to compare runs.
+ *
+ * Example: `run_benchmark("debounce/idle", [&] { debounce(raw, cooked, MATRIX_ROWS, false); });`
+ */
+template <typename F>
+void run_benchmark(const std::string& name, F&& fn) {
+    using clock = std::chrono::steady_clock;
+
+    auto cpu_now = []() {
+        struct timespec ts;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    };
+
+    const auto min_time   = benchmark_min_time();
+    uint64_t   iterations = 1;
+    while (true) {
+        auto real_start = clock::now();
+        auto cpu_start  = cpu_now();
+        for (uint64_t i = 0; i < iterations; i++) {
+            fn();
+        }
+        auto real_elapsed = clock::now() - real_start;
+        auto cpu_elapsed  = cpu_now() - cpu_start;
+
+        if (real_elapsed >= min_time || iterations >= UINT64_MAX / 10) {
+            benchmark_record(name, iterations, std::chrono::duration<double, std::nano>(real_elapsed).count() / iterations, std::chrono::duration<double, std::nano>(cpu_elapsed).count() / iterations);
+            return;
+        }
+
+        // Aim slightly past the minimum time, growing at most tenfold per attempt
+        double   ratio = real_elapsed.count() > 0 ? 1.4 * min_time.count() / real_elapsed.count() : 10;
+        uint64_t next  = iterations * (ratio > 10 ? 10 : ratio);
+        iterations     = next > iterations ? next : iterations + 1;
+    }
+}
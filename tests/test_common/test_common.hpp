@@ -18,6 +18,8 @@
 #include "gmock/gmock.h"
 
 extern "C" {
+// Some of the headers pulled in by quantum.h use C11 static assertions
+#define _Static_assert static_assert
 #include "quantum.h"
 }
 #include "test_driver.hpp"
@@ -29,6 +29,8 @@ void advance_time(uint32_t ms);
 
 using testing::_;
 
+#define KEYMAP_INDEX_KEY(layer, position) (((uint32_t)(layer) << 16) | ((uint32_t)(position).row << 8) | (position).col)
+
 /* This is used for dynamic dispatching keymap_key_to_keycode calls to the current active test_fixture. */
 TestFixture* TestFixture::m_this = nullptr;
 
@@ -99,7 +101,9 @@ void TestFixture::add_key(KeymapKey key) {
         FAIL() << "key is already mapped for layer " << +key.layer << " and (column,row) (" << +key.position.col << "," << +key.position.row << ")";
     }
 
+    this->keymap_index[KEYMAP_INDEX_KEY(key.layer, key.position)] = this->keymap.size();
     this->keymap.push_back(key);
+    layer_lookup_cache_invalidate();
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
@@ -127,18 +131,18 @@ void TestFixture::tap_combo(const std::vector<KeymapKey>& chord_keys, unsigned d
 
 void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
     this->keymap.clear();
+    this->keymap_index.clear();
+    layer_lookup_cache_invalidate();
     for (auto& key : keys) {
         add_key(key);
     }
 }
 
 const KeymapKey* TestFixture::find_key(layer_t layer, keypos_t position) const {
-    auto keymap_key_predicate = [&](KeymapKey candidate) { return candidate.layer == layer && candidate.position.col == position.col && candidate.position.row == position.row; };
-
-    auto result = std::find_if(this->keymap.begin(), this->keymap.end(), keymap_key_predicate);
+    auto result = this->keymap_index.find(KEYMAP_INDEX_KEY(layer, position));
 
-    if (result != std::end(this->keymap)) {
-        return &(*result);
+    if (result != std::end(this->keymap_index)) {
+        return &this->keymap[result->second];
     }
     return nullptr;
 }
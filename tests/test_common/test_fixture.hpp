@@ -68,4 +68,8 @@ class TestFixture : public testing::Test {
    protected:
     void                   print_test_log() const;
     std::vector<KeymapKey> keymap;
+
+   private:
+    // Index into `keymap` by layer and position, as keycodes are looked up on every key event
+    std::unordered_map<uint32_t, size_t> keymap_index;
 };
@@ -0,0 +1,152 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "trace_replay.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "test_logger.hpp"
+#include "test_matrix.h"
+
+extern "C" {
+#include "host.h"
+#include "keyboard.h"
+#ifdef TASK_PROFILER_ENABLE
+#    include "task_profiler.h"
+#endif
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+// Counting host driver, avoiding the overhead of the mocked TestDriver while benchmarking.
+uint32_t keyboard_reports = 0;
+uint32_t other_reports    = 0;
+
+uint8_t keyboard_leds(void) {
+    return 0;
+}
+
+void send_keyboard(report_keyboard_t *report) {
+    keyboard_reports++;
+}
+
+void send_nkro(report_nkro_t *report) {
+    keyboard_reports++;
+}
+
+void send_mouse(report_mouse_t *report) {
+    other_reports++;
+}
+
+void send_extra(report_extra_t *report) {
+    other_reports++;
+}
+
+host_driver_t counting_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra};
+
+uint64_t run_one_loop() {
+    auto start = std::chrono::steady_clock::now();
+    keyboard_task();
+    housekeeping_task();
+    auto end = std::chrono::steady_clock::now();
+    advance_time(1);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+} // namespace
+
+bool TraceReplay::load(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        test_logger.error() << "unable to open trace " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    unsigned    line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           row, col;
+        char               state;
+        if (!(fields >> time >> row >> col >> state) || (state != 'd' && state != 'u') || row >= MATRIX_ROWS || col >= MATRIX_COLS || (!m_events.empty() && time < m_events.back().time)) {
+            test_logger.error() << path << ":" << line_number << ": invalid trace event" << std::endl;
+            return false;
+        }
+
+        add({time, static_cast<uint8_t>(row), static_cast<uint8_t>(col), state == 'd'});
+    }
+    return true;
+}
+
+void TraceReplay::add(TraceEvent event) {
+    m_events.push_back(event);
+}
+
+TraceReplayResult TraceReplay::run(uint32_t tail_ms) {
+    TraceReplayResult result;
+    host_driver_t    *previous_driver = host_get_driver();
+
+    host_set_driver(&counting_driver);
+    keyboard_reports = 0;
+    other_reports    = 0;
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_reset();
+#endif
+
+    auto     start = std::chrono::steady_clock::now();
+    uint32_t now   = 0;
+    for (const TraceEvent &event : m_events) {
+        for (; now < event.time; now++, result.loops++) {
+            result.max_loop_ns = std::max(result.max_loop_ns, run_one_loop());
+        }
+
+        if (event.pressed) {
+            press_key(event.col, event.row);
+        } else {
+            release_key(event.col, event.row);
+        }
+        result.events++;
+    }
+    for (uint32_t i = 0; i <= tail_ms; i++, result.loops++) {
+        result.max_loop_ns = std::max(result.max_loop_ns, run_one_loop());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    result.wall_seconds     = std::chrono::duration<double>(end - start).count();
+    result.keyboard_reports = keyboard_reports;
+    result.other_reports    = other_reports;
+
+    host_set_driver(previous_driver);
+    return result;
+}
+
+std::ostream &operator<<(std::ostream &os, const TraceReplayResult &result) {
+    os << "events:           " << result.events << " (" << std::fixed << std::setprecision(0) << result.events_per_second() << "/s)" << std::endl;
+    os << "main loops:       " << result.loops << " (" << (result.wall_seconds > 0 ? result.loops / result.wall_seconds : 0) << "/s, slowest " << result.max_loop_ns << "ns)" << std::endl;
+    os << "reports:          " << result.keyboard_reports << " keyboard, " << result.other_reports << " other" << std::endl;
+#ifdef TASK_PROFILER_ENABLE
+    for (int stage = 0; stage < TASK_PROFILER_STAGE_COUNT; stage++) {
+        task_profiler_stats_t stats;
+        if (!task_profiler_get_stats(static_cast<task_profiler_stage_t>(stage), &stats) || stats.count == 0) {
+            continue;
+        }
+        uint64_t total_us = stats.total * 1000 / task_profiler_ticks_per_ms();
+        os << std::left << std::setw(22) << task_profiler_stage_name(static_cast<task_profiler_stage_t>(stage)) << std::right << total_us << "us total, " << stats.total / stats.count << " avg, " << stats.p99 << " p99, " << stats.max << " max ticks" << std::endl;
+    }
+#endif // TASK_PROFILER_ENABLE
+    return os;
+}
+
+std::string trace_replay_path(const std::string &fallback) {
+    const char *path = std::getenv("QMK_SIM_TRACE");
+    return path ? path : fallback;
+}
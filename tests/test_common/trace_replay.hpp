@@ -0,0 +1,74 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A single timestamped matrix transition of a recorded keystroke trace.
+ */
+struct TraceEvent {
+    uint32_t time; // milliseconds since the start of the trace
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+/**
+ * @brief Results of replaying a trace through the keyboard pipeline.
+ */
+struct TraceReplayResult {
+    size_t   events           = 0; // matrix transitions replayed
+    uint32_t loops            = 0; // keyboard_task() iterations, one per simulated millisecond
+    uint32_t keyboard_reports = 0; // keyboard and NKRO reports sent to the host
+    uint32_t other_reports    = 0; // mouse and extrakey reports sent to the host
+    double   wall_seconds     = 0; // host time spent replaying
+    uint64_t max_loop_ns      = 0; // slowest single iteration of the main loop
+
+    double events_per_second() const {
+        return wall_seconds > 0 ? events / wall_seconds : 0;
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const TraceReplayResult& result);
+
+/**
+ * @brief Replays recorded keystroke traces through keyboard_task() as fast as the host allows.
+ *
+ * The trace format is one event per line, `<time_ms> <row> <col> <d|u>`, with `#` starting a comment.
+ * Timestamps are relative to the start of the trace and must not decrease.
+ */
+class TraceReplay {
+   public:
+    /**
+     * @brief Parses a trace file, appending its events.
+     *
+     * @return false if the file could not be read, or contains an invalid line
+     */
+    bool load(const std::string& path);
+    void add(TraceEvent event);
+
+    const std::vector<TraceEvent>& events() const {
+        return m_events;
+    }
+
+    /**
+     * @brief Replays all events with mocked time, then idles for `tail_ms` so pending timeouts resolve.
+     *
+     * The host driver is replaced by a counting one for the duration of the replay.
+     */
+    TraceReplayResult run(uint32_t tail_ms = 1000);
+
+   private:
+    std::vector<TraceEvent> m_events;
+};
+
+/**
+ * @brief Path of the trace to replay: the `QMK_SIM_TRACE` environment variable if set, otherwise `fallback`.
+ */
+std::string trace_replay_path(const std::string& fallback);
@@ -0,0 +1,36 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Shared by the tests in tests/simulator, which only differ in their configuration and
+// `simulator_keymap`. Each of them adds this file to its SRC.
+
+#include <iostream>
+#include "test_common.hpp"
+#include "trace_replay.hpp"
+
+extern "C" const uint16_t simulator_keymap[MATRIX_ROWS][MATRIX_COLS];
+
+class Simulator : public TestFixture {
+   public:
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, simulator_keymap[row][col]));
+            }
+        }
+    }
+};
+
+TEST_F(Simulator, ReplayTypingTrace) {
+    TraceReplay replay;
+    ASSERT_TRUE(replay.load(trace_replay_path("tests/simulator/typing.trace")));
+    ASSERT_FALSE(replay.events().empty());
+
+    TraceReplayResult result = replay.run();
+    std::cout << result;
+
+    EXPECT_EQ(result.events, replay.events().size());
+    EXPECT_EQ(result.loops, replay.events().back().time + 1001);
+    EXPECT_GT(result.keyboard_reports, 0);
+    EXPECT_EQ(result.other_reports, 0);
+}
@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TICKLESS_IDLE_SCAN_INTERVAL 100
+#define TICKLESS_IDLE_MAX_SLEEP 150
+#define TAPPING_TERM 40
+#define COMBO_TERM 30
@@ -0,0 +1,103 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+static uint32_t noop_callback(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+
+class TicklessIdle : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Start each test straight after a matrix scan
+        tickless_idle_task();
+    }
+};
+
+TEST_F(TicklessIdle, SleepsUntilNextScan) {
+    EXPECT_EQ(tickless_idle_task(), TICKLESS_IDLE_SCAN_INTERVAL);
+
+    // Time spent in the main loop counts towards the interval
+    advance_time(30);
+    EXPECT_EQ(tickless_idle_task(), TICKLESS_IDLE_SCAN_INTERVAL - 30);
+
+    // Overrunning the interval doesn't sleep at all
+    advance_time(TICKLESS_IDLE_SCAN_INTERVAL + 1);
+    EXPECT_EQ(tickless_idle_task(), 0);
+}
+
+TEST_F(TicklessIdle, WakesForDeferredExec) {
+    deferred_token token = defer_exec(25, noop_callback, NULL);
+    EXPECT_EQ(tickless_idle_task(), 25);
+    EXPECT_TRUE(cancel_deferred_exec(token));
+}
+
+TEST_F(TicklessIdle, WakesAtRequestedTime) {
+    tickless_idle_wake_at(timer_read32() + 60);
+    tickless_idle_wake_at(timer_read32() + 70);
+    EXPECT_EQ(tickless_idle_task(), 60);
+
+    // Requests only apply to the next sleep
+    EXPECT_EQ(tickless_idle_task(), TICKLESS_IDLE_SCAN_INTERVAL);
+}
+
+TEST_F(TicklessIdle, WakeEndsSleepEarly) {
+    tickless_idle_wake();
+    EXPECT_EQ(tickless_idle_task(), 0);
+    EXPECT_EQ(tickless_idle_task(), TICKLESS_IDLE_SCAN_INTERVAL);
+}
+
+TEST_F(TicklessIdle, WakesAtTappingTerm) {
+    TestDriver driver;
+    KeymapKey  mod_tap = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    set_keymap({mod_tap});
+
+    EXPECT_NO_REPORT(driver);
+    uint32_t pressed_at = timer_read32();
+    mod_tap.press();
+    run_one_scan_loop();
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), pressed_at + TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    // Once the key has turned into a hold there's nothing pending
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+    tickless_idle_task();
+    EXPECT_EQ(tickless_idle_task(), TICKLESS_IDLE_SCAN_INTERVAL);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TicklessIdle, WakesAtComboTerm) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 1, 1, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_NO_REPORT(driver);
+    uint32_t pressed_at = timer_read32();
+    key_y.press();
+    run_one_scan_loop();
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), pressed_at + COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    idle_for(COMBO_TERM);
+    VERIFY_AND_CLEAR(driver);
+}